@@ -9,7 +9,12 @@
 	*/
 
 #include "../inc/RPNEvaluator.hpp"
+#include "../inc/compiler.hpp"
+#include "../inc/environment.hpp"
+#include "../inc/factorial.hpp"
+#include "../inc/power.hpp"
 #include "../inc/pseudo_operation.hpp"
+#include "../inc/result_history.hpp"
 #include "../inc/operation.hpp"
 #include "../inc/operator.hpp"
 #include "../inc/token.hpp"
@@ -18,3252 +23,1143 @@
 #include "../inc/integer.hpp"
 #include "../inc/real.hpp"
 #include "../inc/variable.hpp"
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <stack>
-
-//NOTE: Using Big IF, The email I sent with the operator polymorph issue was not resolved in time for the due date. FOr me to get this done in a timely fashion and handed in with the boost tests working, I had to quickly do the Big If. 
+#include <cmath>
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
 using namespace std;
-Operand::pointer_type RPNEvaluator::evaluate(TokenList const& rpnExpression) 
-{
 
-	// postfix algorithm 
-	std::vector<Token::pointer_type> operandStack;
 
-	//get integer values
-	Integer::value_type evaluatedNumber = 0;
-	Integer::value_type operandFirstNum = 0;
-	Integer::value_type operandSecNum = 0;
 
-	//get real operands
-	Real::value_type RealOperandNumFirst = 0.0;
-	Real::value_type RealOperandNumSec = 0.0;
-	Real::value_type evaluatedRealNumber = 0.0;
+namespace {
+	using small_type = Integer::small_type;
+	small_type const SMALL_MIN = numeric_limits<small_type>::min();
+
+
+
+	Operand::pointer_type const NO_VALUE;
 
-	//if its variable
-	Variable::pointer_type variable = nullptr;
-	Variable::pointer_type secondVariable = nullptr;
+	/*! The values of an Environment during a run: a snapshot of its slot array, renewed by each assignment of the run,
+		so reading a variable is an indexed load.  The snapshot is dropped while assigning, so the assignment can
+		update an array nothing else shares in place. */
+	struct environment_view {
+		Environment*				environment;
+		Environment::snapshot_type	values;
 
-	Boolean::pointer_type boolPtr = nullptr;
-	Boolean::pointer_type boolSecondPtr = nullptr;
+		explicit environment_view(Environment* environment)
+			: environment(environment), values(environment ? environment->snapshot() : nullptr) { }
+
+		Operand::pointer_type const& get(size_t slot) const { return slot < values->size() ? (*values)[slot] : NO_VALUE; }
+		void set(size_t slot, Operand::pointer_type value) {
+			values.reset();
+			environment->set(slot, move(value));
+			values = environment->snapshot();
+		}
+	};
+
+	/*! A reference to a Variable token of the expression being evaluated.
+		The value is in the environment's slot of the Variable, if it has both; otherwise it is in the token. */
+	struct variable_ref {
+		Token::pointer_type const*	token;
+		environment_view*			environment;
+
+		Variable* get() const { return static_cast<Variable*>(token->get()); }
+		bool in_environment() const { return environment && environment->environment && get()->get_slot() != Variable::NO_SLOT; }
+		Operand::pointer_type const& get_value() const {
+			return in_environment() ? environment->get(get()->get_slot()) : get()->get_value();
+		}
+		void set_value(Operand::pointer_type const& value) const {
+			if (in_environment())
+				environment->set(get()->get_slot(), value);
+			else
+				get()->set_value(value);
+		}
+	};
 
-	//boolean expressions to determine boolean.
-	bool evaluated = false;
-	bool isReal = false;
-	bool isSecondNum = false;
-	bool isBoolValue = false;
-	bool isSecondBoolValue = false;
+	/*! The alternatives of an unboxed value, in the order of value<REAL>. */
+	enum value_kind_type { V_BOOLEAN, V_SMALL, V_BIG, V_REAL, V_VARIABLE };
 
-	bool boolRealNumberFirst = false;
-	bool boolRealNumberSecond = false;
-	bool boolNumberFirst = false;
-	bool boolNumberSecond = false;
-	bool boolVariables = false;
+	/*! An unboxed evaluation value.  REAL is the value type of the precision tier. */
+	template <typename REAL>
+	using value = variant<bool, small_type, Integer::value_type, REAL, variable_ref>;
 
-	bool variableFirst = false;
-	bool variableSecond = false;
+	/*! An operation kernel.  'args' points at the operation's arguments, left-most first; the result replaces args[0]. */
+	template <typename REAL>
+	using kernel_type = void(*)(value<REAL>* args);
 
-	bool firstBool = false;
-	bool secondBool = false;
 
-	if (rpnExpression.size() == 0)
-	{
-		throw exception("Error: insufficient operands");
+
+	/*! Throw the standard 'cannot perform' error for an operation. */
+	[[noreturn]] void cannot_perform(char const* operationName) {
+		string msg = string("Error: cannot perform <") + operationName + ">";
+		throw exception(msg.c_str());
 	}
 
-	// Loop through the TokenList 
-	for (auto x : rpnExpression)
-	{
-		// Reset the flags
-		if (evaluated == true)
-		{
-			boolRealNumberFirst = false;
-			boolRealNumberSecond = false;
-			boolNumberFirst = false;
-			boolNumberSecond = false;
-			boolVariables = false;
-			isBoolValue = false;
-			isSecondBoolValue = false;
-			evaluated = false;
+
+
+	/*! Unboxes an operand token.  Constants come from the cache at the engine's precision. */
+	template <typename REAL>
+	value<REAL> unbox(Token::pointer_type const& token) {
+		Token const* t = token.get();
+		if (is<Integer>(t)) {
+			Integer const* i = static_cast<Integer const*>(t);
+			if (i->is_small())
+				return value<REAL>(in_place_index<V_SMALL>, i->get_small());
+			return value<REAL>(in_place_index<V_BIG>, i->get_value());
 		}
+		if (is<Boolean>(t))
+			return value<REAL>(in_place_index<V_BOOLEAN>, static_cast<Boolean const*>(t)->get_value());
+		if (is<Pi>(t))
+			return value<REAL>(in_place_index<V_REAL>, real_constants<REAL>::pi());
+		if (is<E>(t))
+			return value<REAL>(in_place_index<V_REAL>, real_constants<REAL>::e());
+		if (is<Real>(t))
+			return value<REAL>(in_place_index<V_REAL>, static_cast<REAL>(static_cast<Real const*>(t)->get_value()));
+		if (is<Variable>(t))
+			return value<REAL>(in_place_index<V_VARIABLE>, variable_ref{ &token, nullptr });
+		throw exception("Error: unknown token");
+	}
 
-		// If token(t) is a operand(Real or Integer) push onto the stack(vector)
-		if (is<Operand>(x))
-		{
-			if (is<Pi>(x))
-			{
-				operandStack.push_back(make<Pi>());
-				continue;
-			}
-			else if (is<E>(x))
-			{
-				operandStack.push_back(make<E>());
-				continue;
-			}
+	/*! Boxes a value into an operand token.
+		A Variable of an environment is boxed as a new Variable token holding its current value. */
+	template <typename REAL>
+	Operand::pointer_type box(value<REAL> const& v) {
+		switch (v.index()) {
+		case V_BOOLEAN:	return make_boolean(get<V_BOOLEAN>(v));
+		case V_SMALL:	return make_integer(get<V_SMALL>(v));
+		case V_BIG:		return make_operand<Integer>(get<V_BIG>(v));
+		case V_REAL:	return make_operand<Real>(Real::value_type(get<V_REAL>(v)));
+		default:		break;
+		}
+
+		variable_ref const& ref = get<V_VARIABLE>(v);
+		if (!ref.in_environment())
+			return static_pointer_cast<Operand>(*ref.token);
+		auto variable = make_shared<Variable>(ref.get()->get_slot());
+		variable->set_value(ref.get_value());
+		return variable;
+	}
+
+	/*! Replaces a variable reference with the variable's value. */
+	template <typename REAL>
+	void dereference(value<REAL>& v) {
+		if (v.index() != V_VARIABLE)
+			return;
+
+		Operand::pointer_type const& boxed = get<V_VARIABLE>(v).get_value();
+		if (!boxed)
+			throw exception("Error: variable not initialized");
+		v = unbox<REAL>(boxed);
+	}
+
+
+
+	/*! Decides a logical operation from its left operand, if it can: false decides And and Nand, true decides Or and Nor.
+		When it does, the operand is replaced by the operation's result. */
+	template <typename REAL>
+	bool short_circuit(value<REAL>& left, unsigned short operation) {
+		bool b;
+		if (left.index() == V_BOOLEAN)
+			b = get<V_BOOLEAN>(left);
+		else if (left.index() == V_VARIABLE && is<Boolean>(get<V_VARIABLE>(left).get_value()))
+			b = get_value<Boolean>(get<V_VARIABLE>(left).get_value());
+		else
+			return false;	// the operation's kernel reports the error
+
+		bool decides = (operation == OP_AND || operation == OP_NAND) ? !b : b;
+		if (!decides)
+			return false;
+		left.template emplace<V_BOOLEAN>((operation == OP_NAND || operation == OP_NOR) ? !b : b);
+		return true;
+	}
+
+
+
+	template <typename REAL> inline bool is_integer(value<REAL> const& v) { return v.index() == V_SMALL || v.index() == V_BIG; }
+	template <typename REAL> inline bool is_numeric(value<REAL> const& v) { return v.index() >= V_SMALL && v.index() <= V_REAL; }
+
+	template <typename REAL>
+	inline Integer::value_type int_of(value<REAL> const& v) {
+		return v.index() == V_SMALL ? Integer::value_type(get<V_SMALL>(v)) : get<V_BIG>(v);
+	}
+
+	/*! Gets a numeric value as the engine's real type; Integers are promoted. */
+	template <typename REAL>
+	REAL real_of(value<REAL> const& v) {
+		switch (v.index()) {
+		case V_SMALL:	return static_cast<REAL>(get<V_SMALL>(v));
+		case V_BIG:		return static_cast<REAL>(get<V_BIG>(v));
+		default:		return get<V_REAL>(v);
+		}
+	}
+
+	/*! Stores an Integer result, inline if it fits. */
+	template <typename REAL>
+	inline void set_integer(value<REAL>& v, Integer::value_type const& i) {
+		if (i >= SMALL_MIN && i <= numeric_limits<small_type>::max())
+			v.template emplace<V_SMALL>(static_cast<small_type>(i));
+		else
+			v.template emplace<V_BIG>(i);
+	}
+
+
+
+	/*! Applies a numeric operation that preserves Integer-ness: Integer op Integer -> Integer, otherwise Real.
+		Small Integers are tried with smallFn first, which returns false when the result does not fit a small_type. */
+	template <typename REAL, typename SMALL_FN, typename INT_FN, typename REAL_FN>
+	void numeric_binary(value<REAL>* args, char const* name, SMALL_FN smallFn, INT_FN intFn, REAL_FN realFn) {
+		dereference(args[0]);
+		dereference(args[1]);
+		value<REAL>& lhs = args[0];
+		value<REAL> const& rhs = args[1];
+		if (is_integer(lhs) && is_integer(rhs)) {
+			small_type result;
+			if (lhs.index() == V_SMALL && rhs.index() == V_SMALL && smallFn(get<V_SMALL>(lhs), get<V_SMALL>(rhs), result))
+				lhs.template emplace<V_SMALL>(result);
+			else
+				set_integer(lhs, intFn(int_of(lhs), int_of(rhs)));
+			return;
+		}
+		if (!is_numeric(lhs) || !is_numeric(rhs))
+			cannot_perform(name);
+		lhs.template emplace<V_REAL>(realFn(real_of(lhs), real_of(rhs)));
+	}
+
+	/*! Applies a numeric operation to a single Integer or Real argument.  Small Integers are tried with smallFn first. */
+	template <typename REAL, typename SMALL_FN, typename INT_FN, typename REAL_FN>
+	void numeric_unary(value<REAL>* args, char const* name, SMALL_FN smallFn, INT_FN intFn, REAL_FN realFn) {
+		dereference(args[0]);
+		value<REAL>& arg = args[0];
+		small_type result;
+		switch (arg.index()) {
+		case V_SMALL:
+			if (smallFn(get<V_SMALL>(arg), result))
+				arg.template emplace<V_SMALL>(result);
 			else
-				operandStack.push_back(x);
+				set_integer(arg, intFn(int_of(arg)));
+			return;
+		case V_BIG:
+			set_integer(arg, intFn(get<V_BIG>(arg)));
+			return;
+		case V_REAL:
+			arg.template emplace<V_REAL>(realFn(get<V_REAL>(arg)));
+			return;
 		}
+		cannot_perform(name);
+	}
+
+	/*! Applies a Real function to a single Integer or Real argument; Integers are promoted. */
+	template <typename REAL, typename REAL_FN>
+	void real_unary(value<REAL>* args, char const* name, REAL_FN realFn) {
+		dereference(args[0]);
+		if (!is_numeric(args[0]))
+			cannot_perform(name);
+		args[0].template emplace<V_REAL>(realFn(real_of(args[0])));
+	}
+
+	/*! Applies a logical operation to two Booleans. */
+	template <typename REAL, typename FN>
+	void logical_binary(value<REAL>* args, char const* name, FN fn) {
+		dereference(args[0]);
+		dereference(args[1]);
+		if (args[0].index() != V_BOOLEAN || args[1].index() != V_BOOLEAN)
+			cannot_perform(name);
+		args[0].template emplace<V_BOOLEAN>(fn(get<V_BOOLEAN>(args[0]), get<V_BOOLEAN>(args[1])));
+	}
+
+	/*! Applies a comparison; Booleans compare with Booleans (false < true), numbers with numbers. */
+	template <typename REAL, typename FN>
+	void relational(value<REAL>* args, char const* name, FN fn) {
+		dereference(args[0]);
+		dereference(args[1]);
+		value<REAL> const& lhs = args[0];
+		value<REAL> const& rhs = args[1];
+		bool result;
+		if (lhs.index() == V_BOOLEAN && rhs.index() == V_BOOLEAN)
+			result = fn(get<V_BOOLEAN>(lhs), get<V_BOOLEAN>(rhs));
+		else if (lhs.index() == V_SMALL && rhs.index() == V_SMALL)
+			result = fn(get<V_SMALL>(lhs), get<V_SMALL>(rhs));
+		else if (is_integer(lhs) && is_integer(rhs))
+			result = fn(int_of(lhs), int_of(rhs));
+		else if (is_numeric(lhs) && is_numeric(rhs))
+			result = fn(real_of(lhs), real_of(rhs));
 		else
-		{
-			// Cast the token to an Operand token
-			Operation::pointer_type operationPTR = dynamic_pointer_cast<Operation>(x);
-
-			// Return the first and second numbers of both the integer and the real numbers back to 0
-			operandFirstNum = 0;
-			operandSecNum = 0;
-			RealOperandNumFirst = 0.0;
-			RealOperandNumSec = 0.0;
-
-			// Check if the number of arguments whether it is a Unary operator or a Binary operator
-			// is greater than the number of arguments in the operands stack(vector)
-			// If so throw an exception
-			if (operationPTR->number_of_args() > operandStack.size())
-			{
-				throw exception("Insufficient number of operands for operation");
-			}
+			cannot_perform(name);
+		args[0].template emplace<V_BOOLEAN>(result);
+	}
 
-			// Loop through the operands stack(vector) to pop off the same number of operands
-			// as the number of arguments needed for the operator
-			for (size_t i = 1; i <= operationPTR->number_of_args(); ++i)
-			{
-				// Check the back of the operands stack if it is a real number or a integer
-				// There should only be a maximum of 2 operands used at anyone time in the evaluation
-				if (is<Integer>(operandStack.back()))
-				{
-					if (i == 1)
-					{
-						// Cast the pointer at the back of the vector to an Integer pointer type
-						Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(operandStack.back());
-
-						// Get the numeric value of the pointer
-						operandFirstNum = intPtr->get_value();
-						boolNumberFirst = true;
-
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-					else if (i == 2)
-					{
-						// If there are two arguments for the operand then there is a second operand. 
-						// Set this flag to true to say there is two operands.
-						isSecondNum = true;
-
-						// Cast the pointer at the back of the vector to an Integer pointer type
-						Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(operandStack.back());
-
-						// Get the numeric value of the pointer
-						operandSecNum = intPtr->get_value();
-						boolNumberSecond = true;
-
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-				}
-				else if (is<Real>(operandStack.back()))
-				{
-					isReal = true;
-
-					if (i == 1)
-					{
-						// Cast the pointer at the back of the vector to an Real number pointer type
-						Real::pointer_type realPtr = dynamic_pointer_cast<Real>(operandStack.back());
-
-						// Get the numeric value of the pointer
-						RealOperandNumFirst = realPtr->get_value();
-						boolRealNumberFirst = true;
-
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-					else if (i == 2)
-					{
-						// If there are two arguments for the operand then there is a second operand. 
-						// Set this flag to true to say there is two operands.
-						isSecondNum = true;
-
-						// Cast the pointer at the back of the vector to an Real number pointer type
-						Real::pointer_type realPtr = dynamic_pointer_cast<Real>(operandStack.back());
-
-						// Get the numeric value of the pointer
-						RealOperandNumSec = realPtr->get_value();
-						boolRealNumberSecond = true;
-
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-				}
-				else if (is<Boolean>(operandStack.back()))
-				{
-					// Flag to say that there is a boolean value
-					isBoolValue = true;
-
-					if (i == 1)
-					{
-						// Cast the pointer at the back of the vector to an Boolean pointer type
-						Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(operandStack.back());
-
-						// Get the value of the bool (true or false)
-						firstBool = boolPtr->get_value();
-
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-					else if (i == 2)
-					{
-						// Flag to say that there are two boolean values
-						isSecondBoolValue = true;
 
-						// Cast the pointer at the back of the vector to an Boolean pointer type
-						Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(operandStack.back());
 
-						// Get the value of the bool (true or false)
-						secondBool = boolPtr->get_value();
+	/*! Raises a small base to a non-negative exponent by squaring; returns false on overflow. */
+	bool checked_power(small_type base, small_type exponent, small_type& result) {
+		result = 1;
+		if (base == 0 || base == 1 || base == -1) {
+			result = base == -1 ? ((exponent & 1) ? -1 : 1) : (exponent == 0 ? 1 : base);
+			return true;
+		}
+		while (exponent > 0) {
+			if ((exponent & 1) && !checked_multiply(result, base, result))
+				return false;
+			exponent >>= 1;
+			if (exponent > 0 && !checked_multiply(base, base, base))
+				return false;
+		}
+		return true;
+	}
 
-						// Pop the pointer off the vector and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-				}
-				else if (is<Variable>(operandStack.back()))
-				{
-					// Flag to say that it is a variable that may be assigned a value
-					boolVariables = true;
-
-					if (i == 1)
-					{
-						// Flag to say which variable is being used
-						variableFirst = true;
-
-						// Cast the Variable to variable pointer to be able to empty the stack
-						variable = dynamic_pointer_cast<Variable>(operandStack.back());
-
-						if (Real::pointer_type real = dynamic_pointer_cast<Real>(variable->get_value()))
-						{
-							isReal = true;
-						}
-
-						// Pop the pointer off the vector(stack) and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-					else if (i == 2)
-					{
-						// Flag to say which variable is being used
-						variableSecond = true;
-
-						// Cast the Variable to variable pointer to be able to empty the stack
-						secondVariable = dynamic_pointer_cast<Variable>(operandStack.back());
-
-						if (Real::pointer_type real = dynamic_pointer_cast<Real>(secondVariable->get_value()))
-						{
-							isReal = true;
-						}
-
-						// Pop the pointer off the vector(stack) and continue through the loop
-						operandStack.pop_back();
-						continue;
-					}
-				}
-			}
 
-			// If Operation is NonAssociative (i.e a Unary Operator)
-			if (is<NonAssociative>(operationPTR))
-			{
-				if (is<Negation>(operationPTR))
-				{
-					if (boolVariables == false)
-					{
-						// If there is more than one operand, the throw an error stating there
-						// are too many operands
-						if (isSecondNum == true || isBoolValue == true)
-							throw exception("Error: too many operands");
-						else
-						{
-							// Check if it is a Real number or not, multiple by -1 for a sign change
-							// then push back onto the operands vector
-							if (isReal == false)
-							{
-								operandFirstNum *= -1;
-								operandStack.push_back(make<Integer>(operandFirstNum));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								RealOperandNumFirst *= -1.0;
-								operandStack.push_back(make<Real>(RealOperandNumFirst));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					else if (boolVariables == true)
-					{
-						if (Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(variable->get_value()))
-						{
-							Integer::value_type newIntPtr = intPtr->get_value() * -1;
-							Token::pointer_type intToken = make<Integer>(newIntPtr);
-							Integer::pointer_type intPtrVariable = dynamic_pointer_cast<Integer>(intToken);
-							Variable::pointer_type newIntVar = dynamic_pointer_cast<Variable>(intToken);
-							newIntVar->set_value(intPtrVariable);
-							operandStack.push_back(newIntVar);
-							evaluated = true;
-							continue;
-						}
-						else if (Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value()))
-						{
-							Real::value_type newRealPtr = realPtr->get_value() * -1;
-							Token::pointer_type realToken = make<Real>(newRealPtr);
-							Real::pointer_type realPtrVariable = dynamic_pointer_cast<Real>(realToken);
-							Variable::pointer_type newRealVar = dynamic_pointer_cast<Variable>(realToken);
-							newRealVar->set_value(realPtrVariable);
-							operandStack.push_back(newRealVar);
-							evaluated = true;
-							continue;
-						}
-					}
-				}
-				else if (is<Identity>(operationPTR))
-				{
-					// Check if it is a Real number or not, then push back onto the operands vector
-					if (isReal == false)
-					{
-						operandStack.push_back(make<Integer>(operandFirstNum));
-						evaluated = true;
-						continue;
-					}
-					else
-					{
-						operandStack.push_back(make<Real>(RealOperandNumFirst));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Not>(operationPTR))
-				{
-					//Variable::pointer_type newVariable = nullptr;
-					// Check that there is only bool value to operate on
-					if (isSecondBoolValue == true)
-					{
-						throw exception("Error: too many operands");
-					}
-					else
-					{
-						// Check to see if there is a bool, or numeric value to operate on
-						// If it is a bool value, then change the value to the opposite of its
-						// current value. If it is a numeric value greater than 0, then the value
-						// will be changed to 0, otherwise if the value is 0, then the value will 
-						// be changed to the value of 1 for Integer or 1.0 for Real
-						if (isBoolValue == true && firstBool == false)
-						{
-							firstBool = true;
-							operandStack.push_back(make<Boolean>(firstBool));
-							evaluated = true;
-							continue;
-						}
-						else if (isBoolValue == true && firstBool == true)
-						{
-							firstBool = false;
-							operandStack.push_back(make<Boolean>(firstBool));
-							evaluated = true;
-							continue;
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							if (boolPtr->get_value() == true)
-							{
-								// Convert value to a token pointer, make a New variable token pointer which will then take 
-								// the value of the first token pointer you have converted and sets the New variable token
-								// pointer value to the pointer type that you have converted to.
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								Token::pointer_type newVar = make<Variable>();
-								Variable::pointer_type newVariable = dynamic_pointer_cast<Variable>(newVar);
-								newVariable->set_value(newBoolValue);
-								operandStack.push_back(newVariable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false)
-							{
-								// Convert value to a token pointer, make a New variable token pointer which will then take 
-								// the value of the first token pointer you have converted and sets the New variable token
-								// pointer value to the pointer type that you have converted to.
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								Token::pointer_type newVar = make<Variable>();
-								Variable::pointer_type newVariable = dynamic_pointer_cast<Variable>(newVar);
-								newVariable->set_value(newBoolValue);
-								operandStack.push_back(newVariable);
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
-				else if (is<PostfixOperator>(operationPTR) || is<Factorial>(operationPTR))
-				{
-					// Check that there are not two operands for the postfix(factorial) to operate on
-					if (isSecondNum == true)
-					{
-						throw exception("Error: too many operands");
-					}
-					if (boolVariables == false)
-					{
-						if (isReal == false)
-						{
-							// Factorial Calculation for an Integer. It uses the operandFirstNum variable
-							// to tell the loop how many times to iterate through the loop.
-							Integer::value_type accumlatedFactorial = 1;
-							for (Integer::value_type i = 2; i <= operandFirstNum; ++i)
-								accumlatedFactorial *= i;
-
-							// Push the calculated factorial onto the vector
-							operandStack.push_back(make<Integer>(accumlatedFactorial));
-							evaluated = true;
-							continue;
-						}
-						else if (isReal == true)
-						{
-							// Factorial Calculation for a Real numberr. It uses the RealOperandNumFirst variable
-							// to tell the loop how many times to iterate through the loop.
-							Real::value_type accumlatedRealFactorial = 1.0;
-							for (Real::value_type i = 2.0; i <= RealOperandNumFirst; ++i)
-								accumlatedRealFactorial *= i;
-
-							// Push the calculated factorial onto the vector
-							operandStack.push_back(make<Real>(accumlatedRealFactorial));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (boolVariables == true)
-					{
-						if (Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(variable->get_value()))
-						{
-							Integer::value_type newIntPtr = intPtr->get_value();
-
-							// Factorial Calculation for an Integer. It uses the operandFirstNum variable
-							// to tell the loop how many times to iterate through the loop.
-							Integer::value_type accumlatedFactorial = 1;
-							for (Integer::value_type i = 2; i <= newIntPtr; ++i)
-								accumlatedFactorial *= i;
-
-							// Convert value to a token pointer, make a New variable token pointer which will then take 
-								// the value of the first token pointer you have converted and sets the New variable token
-								// pointer value to the pointer type that you have converted to.
-							Token::pointer_type intToken = make<Integer>(accumlatedFactorial);
-							Integer::pointer_type intPtrVariable = dynamic_pointer_cast<Integer>(intToken);
-							Variable::pointer_type newIntVar = dynamic_pointer_cast<Variable>(intToken);
-							newIntVar->set_value(intPtrVariable);
-							operandStack.push_back(newIntVar);
-							evaluated = true;
-							continue;
-						}
-						else if (Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value()))
-						{
-							Real::value_type newRealPtr = realPtr->get_value();
-
-							// Factorial Calculation for a Real numberr. It uses the RealOperandNumFirst variable
-							// to tell the loop how many times to iterate through the loop.
-							Real::value_type accumlatedRealFactorial = 1.0;
-							for (Real::value_type i = 2.0; i <= newRealPtr; ++i)
-								accumlatedRealFactorial *= i;
-
-							// Convert value to a token pointer, make a New variable token pointer which will then take 
-								// the value of the first token pointer you have converted and sets the New variable token
-								// pointer value to the pointer type that you have converted to.
-							Token::pointer_type realToken = make<Real>(accumlatedRealFactorial);
-							Real::pointer_type realPtrVariable = dynamic_pointer_cast<Real>(realToken);
-							Variable::pointer_type newRealVar = dynamic_pointer_cast<Variable>(realToken);
-							newRealVar->set_value(realPtrVariable);
-							operandStack.push_back(newRealVar);
-							evaluated = true;
-							continue;
-						}
-					}
-				}
+	/*! The largest denominator of an exponent raised exactly, and the largest exact result in bytes. */
+	constexpr small_type MAX_EXACT_ROOT = 16;
+	constexpr size_t MAX_EXACT_POWER_BYTES = 1024;
+
+	/*! Raises a whole base to a rational exponent p/q (q <= MAX_EXACT_ROOT) when the q-th root of the base is whole:
+		the root and its p-th power are Integers, so the result is rounded only once, to REAL.
+		Returns false if the power is not of that form. */
+	template <typename REAL>
+	bool exact_power(REAL const& base, REAL const& exponent, REAL& result) {
+		REAL const limit = REAL(small_type(1) << 62);
+		if (base == 0 || base != floor(base) || !(abs(base) < limit))
+			return false;
+
+		// p/q is the exponent if it rounds to it; a negative base takes whole exponents only, as pow() does
+		if (!(abs(exponent) < limit / MAX_EXACT_ROOT))
+			return false;
+		small_type q = 1;
+		REAL scaled = exponent;
+		while (REAL(static_cast<small_type>(round(scaled))) / REAL(q) != exponent) {
+			if (++q > MAX_EXACT_ROOT || base < 0)
+				return false;
+			scaled = exponent * REAL(q);
+		}
+		small_type const p = static_cast<small_type>(round(scaled));
+
+		// the whole q-th root of |base|, if there is one, is next to the floating point root
+		Integer::value_type const magnitude = Integer::value_type(abs(static_cast<small_type>(base)));
+		small_type const estimate = llround(std::pow(magnitude.convert_to<double>(), 1.0 / double(q)));
+		Integer::value_type root = -1;
+		for (small_type r = max<small_type>(estimate - 1, 1); r <= estimate + 1 && root < 0; ++r)
+			if (integer_power(Integer::value_type(r), Integer::value_type(q)) == magnitude)
+				root = r;
+		if (root < 0)
+			return false;
+
+		Integer::value_type const e = Integer::value_type(p < 0 ? -p : p);
+		if (integer_power_bytes(root, e) > MAX_EXACT_POWER_BYTES)
+			return false;
+		Integer::value_type power = integer_power(root, e);
+		if (base < 0 && (p & 1))
+			power = -power;
+		result = p < 0 ? REAL(1) / static_cast<REAL>(power) : static_cast<REAL>(power);
+		return true;
+	}
+
+	/*! Raises a real base to a real exponent.  Whole bases with rational exponents are exact (see exact_power());
+		other powers go through pow(), which rounds once rather than at every multiplication.
+		The row kernels and the double-tier column path both use it, so they agree. */
+	template <typename REAL>
+	REAL real_power(REAL const& base, REAL const& exponent) {
+		REAL result;
+		if (exact_power(base, exponent, result))
+			return result;
+		return REAL(pow(base, exponent));
+	}
+
+
+	/*! Raises base to exponent, dispatching on the operand types.
+		Integer ** non-negative Integer is an Integer, computed inline while it fits a small_type;
+		anything else is a Real.  Integer results are sized before they are computed (see integer_power()). */
+	template <typename REAL>
+	void power(value<REAL>* args, char const* name) {
+		dereference(args[0]);
+		dereference(args[1]);
+		value<REAL>& base = args[0];
+		value<REAL> const& exponent = args[1];
+		if (!is_numeric(base) || !is_numeric(exponent))
+			cannot_perform(name);
+
+		switch (exponent.index()) {
+		case V_SMALL: {
+			small_type const e = get<V_SMALL>(exponent);
+			small_type result;
+			if (base.index() == V_SMALL && e >= 0 && checked_power(get<V_SMALL>(base), e, result))
+				base.template emplace<V_SMALL>(result);
+			else if (is_integer(base) && e >= 0)
+				set_integer(base, integer_power(int_of(base), Integer::value_type(e)));
+			else
+				base.template emplace<V_REAL>(real_power(real_of(base), REAL(e)));
+			return;
+		}
+		case V_BIG:
+			if (is_integer(base) && get<V_BIG>(exponent) > 0)
+				set_integer(base, integer_power(int_of(base), get<V_BIG>(exponent)));
+			else	// |base ** exponent| is 0, 1 or out of range
+				base.template emplace<V_REAL>(real_power(real_of(base), static_cast<REAL>(get<V_BIG>(exponent))));
+			return;
+		default:
+			base.template emplace<V_REAL>(real_power(real_of(base), get<V_REAL>(exponent)));
+		}
+	}
+
+
+
+	// Operator kernels
+	// ================
+	template <typename REAL>
+	void k_power(value<REAL>* args) { power(args, "Power"); }
+
+	template <typename REAL>
+	void k_assignment(value<REAL>* args) {
+		if (args[0].index() != V_VARIABLE)
+			throw exception("Error: assignment to a non-variable.");
+		dereference(args[1]);
+		get<V_VARIABLE>(args[0]).set_value(box(args[1]));
+	}
+
+	template <typename REAL>
+	void k_addition(value<REAL>* args) {
+		numeric_binary(args, "Addition",
+			checked_add,
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return l + r; },
+			[](REAL const& l, REAL const& r) -> REAL { return l + r; });
+	}
+
+	template <typename REAL>
+	void k_subtraction(value<REAL>* args) {
+		numeric_binary(args, "Subtraction",
+			checked_subtract,
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return l - r; },
+			[](REAL const& l, REAL const& r) -> REAL { return l - r; });
+	}
+
+	template <typename REAL>
+	void k_multiplication(value<REAL>* args) {
+		numeric_binary(args, "Multiplication",
+			checked_multiply,
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return l * r; },
+			[](REAL const& l, REAL const& r) -> REAL { return l * r; });
+	}
+
+	template <typename REAL>
+	void k_division(value<REAL>* args) {
+		numeric_binary(args, "Division",
+			[](small_type l, small_type r, small_type& q) { if (r == 0 || (r == -1 && l == SMALL_MIN)) return false; q = l / r; return true; },
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return l / r; },
+			[](REAL const& l, REAL const& r) -> REAL { return l / r; });
+	}
+
+	template <typename REAL>
+	void k_modulus(value<REAL>* args) {
+		dereference(args[0]);
+		dereference(args[1]);
+		if (!is_integer(args[0]) || !is_integer(args[1]))
+			cannot_perform("Modulus");
+		if (args[0].index() == V_SMALL && args[1].index() == V_SMALL) {
+			small_type l = get<V_SMALL>(args[0]);
+			small_type r = get<V_SMALL>(args[1]);
+			if (r != 0 && r != -1) {
+				args[0].template emplace<V_SMALL>(small_type(l % r));
+				return;
 			}
+		}
+		set_integer(args[0], Integer::value_type(int_of(args[0]) % int_of(args[1])));
+	}
 
-			// Check if operation is a Binary operator
-			if (is<BinaryOperator>(operationPTR))
-			{
-				// Check if the operator is the Power operation (2^4) = 16
-				if (is<Power>(operationPTR))
-				{
-					// Variables to hold the lexical cast numbers
-					Real::value_type resultRealPower;
-					Real::value_type valueRealFirst;
-					Real::value_type valueRealSecond;
-
-					Integer::value_type resultIntegerPower;
-					Integer::value_type valueIntegerFirst;
-					Integer::value_type valueIntegerSecond;
-
-					// Check to see if the operands are only Integers
-					if (isReal == false)
-					{
-						// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-						// operand numbers to be able to use the pow() function;					
-						int powerNumber = boost::lexical_cast<int>(operandFirstNum);
-
-						if (powerNumber < 0)
-						{
-							// Cast the base number to a Real number because if the exponent number(powerNum) is
-							// a negative number then the result will be a Real number
-							valueRealSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-							Token::pointer_type realNumber = make<Real>(valueRealSecond);
-							valueRealSecond = get_value<Real>(realNumber);
-
-							resultRealPower = boost::multiprecision::pow(valueRealSecond, powerNumber);
-
-							// Push the real number result onto the operand stack(vector)
-							operandStack.push_back(make<Real>(resultRealPower));
-							evaluated = true;
-							continue;
-						}
-						else if (powerNumber > 0)
-						{
-							// Calculate the power
-							resultIntegerPower = boost::multiprecision::pow(operandSecNum, powerNumber);
-
-							// Push the integer Result onto the operand stack(vector)
-							operandStack.push_back(make<Integer>(resultIntegerPower));
-							evaluated = true;
-							continue;
-						}
-						else if (powerNumber == 0)
-						{
-							// Push the integer Result onto the operand stack(vector)
-							operandStack.push_back(make<Integer>(1));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == true)
-					{
-
-						if (boolRealNumberFirst == true && boolNumberSecond == true)
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(RealOperandNumFirst);
-
-							valueRealFirst = boost::lexical_cast<Real::value_type>(operandSecNum);
-							Token::pointer_type realNumber = make<Real>(valueRealFirst);
-							valueRealFirst = get_value<Real>(realNumber);
-
-							Real::value_type realResult = boost::multiprecision::pow(valueRealFirst, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else if (boolNumberFirst == true && boolRealNumberSecond == true)
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(operandFirstNum);
-
-							Real::value_type realResult = pow(RealOperandNumSec, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else if (boolRealNumberSecond == true && boolRealNumberFirst == true)
-						{
-							// Get the result of the power of 2 real numbers
-							Real::value_type realResult = boost::multiprecision::pow(RealOperandNumSec, RealOperandNumFirst);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(RealOperandNumFirst);
-
-							Real::value_type realResult = pow(RealOperandNumSec, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-					}
-				}
+	template <typename REAL>
+	void k_and(value<REAL>* args) { logical_binary(args, "And", [](bool l, bool r) { return l && r; }); }
+	template <typename REAL>
+	void k_nand(value<REAL>* args) { logical_binary(args, "Nand", [](bool l, bool r) { return !(l && r); }); }
+	template <typename REAL>
+	void k_or(value<REAL>* args) { logical_binary(args, "Or", [](bool l, bool r) { return l || r; }); }
+	template <typename REAL>
+	void k_nor(value<REAL>* args) { logical_binary(args, "Nor", [](bool l, bool r) { return !(l || r); }); }
+	template <typename REAL>
+	void k_xor(value<REAL>* args) { logical_binary(args, "Xor", [](bool l, bool r) { return l != r; }); }
+	template <typename REAL>
+	void k_xnor(value<REAL>* args) { logical_binary(args, "Xnor", [](bool l, bool r) { return l == r; }); }
+
+	template <typename REAL>
+	void k_equality(value<REAL>* args) { relational(args, "Equality", [](auto const& l, auto const& r) { return l == r; }); }
+	template <typename REAL>
+	void k_inequality(value<REAL>* args) { relational(args, "Inequality", [](auto const& l, auto const& r) { return l != r; }); }
+	template <typename REAL>
+	void k_greater(value<REAL>* args) { relational(args, "Greater", [](auto const& l, auto const& r) { return l > r; }); }
+	template <typename REAL>
+	void k_greater_equal(value<REAL>* args) { relational(args, "GreaterEqual", [](auto const& l, auto const& r) { return l >= r; }); }
+	template <typename REAL>
+	void k_less(value<REAL>* args) { relational(args, "Less", [](auto const& l, auto const& r) { return l < r; }); }
+	template <typename REAL>
+	void k_less_equal(value<REAL>* args) { relational(args, "LessEqual", [](auto const& l, auto const& r) { return l <= r; }); }
+
+	template <typename REAL>
+	void k_identity(value<REAL>* args) {
+		numeric_unary(args, "Identity",
+			[](small_type v, small_type& r) { r = v; return true; },
+			[](Integer::value_type const& v) -> Integer::value_type { return v; },
+			[](REAL const& v) -> REAL { return v; });
+	}
 
-				if (is<Assignment>(operationPTR))
-				{
-					if ((boolNumberFirst == true || boolRealNumberFirst == true) &&
-						(boolNumberSecond == true || boolRealNumberSecond == true))
-					{
-						throw exception("Error: Cannot assign to a literal value.");
-					}
+	template <typename REAL>
+	void k_negation(value<REAL>* args) {
+		numeric_unary(args, "Negation",
+			[](small_type v, small_type& r) { if (v == SMALL_MIN) return false; r = -v; return true; },
+			[](Integer::value_type const& v) -> Integer::value_type { return -v; },
+			[](REAL const& v) -> REAL { return -v; });
+	}
 
-					if (boolVariables == true)
-					{
-						if (boolNumberFirst == true)
-						{
-							// Convert the operand value to a Token pointer, then to an Integer value
-							Token::pointer_type operandToken = make<Integer>(operandFirstNum);
-							Integer::pointer_type integerVariable = dynamic_pointer_cast<Integer>(operandToken);
-
-							// Set the variable Variable::pointer_type value to an Integer::pointer_type, because the 
-							// value of the Variable::pointer_type is a Operand::pointer_type
-							if (variableFirst == true)
-							{
-								variable->set_value(integerVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(variable);
-							}
-							else if (variableSecond == true)
-							{
-								secondVariable->set_value(integerVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(secondVariable);
-							}
-							continue;
-						}
-						else if (boolRealNumberFirst == true)
-						{
-							// Convert the operand value to a Token pointer, then to an Real number value
-							Token::pointer_type operandToken = make<Real>(RealOperandNumFirst);
-							Real::pointer_type realVariable = dynamic_pointer_cast<Real>(operandToken);
-
-							// Set the variable Variable::pointer_type value to an Real::pointer_type, because the 
-							// value of the Variable::pointer_type is a Operand::pointer_type
-							if (variableFirst == true)
-							{
-								variable->set_value(realVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(variable);
-							}
-							else if (variableSecond == true)
-							{
-								secondVariable->set_value(realVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(secondVariable);
-							}
-							continue;
-						}
-						else if (isBoolValue == true)
-						{
-							// Convert the operand value to a Token pointer, then to an Boolean value
-							Token::pointer_type operandToken = make<Boolean>(firstBool);
-							Boolean::pointer_type booleanVariable = dynamic_pointer_cast<Boolean>(operandToken);
-
-							// Set the variable Variable::pointer_type value to an Boolean::pointer_type, because the 
-							// value of the Variable::pointer_type is a Operand::pointer_type
-							if (variableFirst == true)
-							{
-								variable->set_value(booleanVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(variable);
-							}
-							else if (variableSecond == true)
-							{
-								secondVariable->set_value(booleanVariable);
-
-								// Push it onto the operands stack(vector)
-								operandStack.push_back(secondVariable);
-							}
-							continue;
-						}
-					}
-					else if (!boolVariables && (boolNumberFirst == true || boolRealNumberFirst == true || isBoolValue == true))
-					{
-						throw exception("Error: assignment to a non-variable.");
-					}
-				}
+	template <typename REAL>
+	void k_not(value<REAL>* args) {
+		dereference(args[0]);
+		if (args[0].index() != V_BOOLEAN)
+			cannot_perform("Not");
+		args[0].template emplace<V_BOOLEAN>(!get<V_BOOLEAN>(args[0]));
+	}
 
+	/*! n! of an Integer, or of the whole part of a Real; 1 for n < 2. */
+	template <typename REAL>
+	void k_factorial(value<REAL>* args) {
+		numeric_unary(args, "Factorial",
+			small_factorial,
+			[](Integer::value_type const& n) -> Integer::value_type {
+				if (n < 2)
+					return 1;
+				if (n > numeric_limits<small_type>::max())
+					throw exception("Error: factorial argument too large");
+				return factorial(static_cast<small_type>(n));
+			},
+			[](REAL const& n) -> REAL {
+				REAL const whole = floor(n);
+				if (whole < 2)
+					return 1;
+				if (!(whole < REAL(numeric_limits<small_type>::max() / 2)))
+					throw exception("Error: factorial argument too large");
+				return real_factorial<REAL>(static_cast<small_type>(whole));
+			});
+	}
 
-				// If operator is multiplication, perform the operation one the operands
-				if (is<Multiplication>(operationPTR))
-				{
-					if ((boolNumberFirst == true || boolRealNumberFirst == true || variableFirst == true) &&
-						(boolNumberSecond == false && boolRealNumberSecond == false && variableSecond == false))
-					{
-						throw exception("Error: Not enough operands.");
-					}
 
-					if (boolVariables == false)
-					{
-						// If the operands are both Integer's perform the multiplication on it and push the product
-						// onto the stack(vector)
-						if (isReal == false)
-						{
-							Integer::value_type product = operandFirstNum * operandSecNum;
-							operandStack.push_back(make<Integer>(product));
-							evaluated = true;
-							continue;
-						}
-						else if (isReal == true)
-						{
-							// Variables to hold the real number values
-							Real::value_type productReal;
-							Real::value_type valueFirst;
-							Real::value_type valueSecond;
-
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to use the multiply								
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								productReal = valueSecond * RealOperandNumFirst;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(productReal));
-								evaluated = true;
-								continue;
-							}
-							else if (boolNumberFirst == true && boolRealNumberSecond == true)
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								productReal = valueFirst * RealOperandNumSec;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(productReal));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								productReal = RealOperandNumSec * RealOperandNumFirst;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(productReal));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					else if (boolVariables == true)
-					{
-						if (isReal == false)
-						{ //*****
-							if (boolNumberFirst == true && variableSecond == true)
-							{
-								Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(secondVariable->get_value());
-								Integer::value_type product = operandFirstNum * integerPtr->get_value();
-								operandStack.push_back(make<Integer>(product));
-								evaluated = true;
-								continue;
-							}
-							else if (boolNumberSecond == true && variableFirst == true)
-							{
-								Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(variable->get_value());
-								Integer::value_type product = operandSecNum * integerPtr->get_value();
-								operandStack.push_back(make<Integer>(product));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							// Variables to hold the real number values
-							Real::value_type product;
-
-							if ((boolRealNumberFirst == true || boolNumberFirst == true) && variableSecond == true)
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to use the multiply								
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(secondVariable->get_value());
-
-								// If both oerands are real numbers than just multiply, else if one is a integer
-								// and one is a real convert the integer to a real number
-								if (boolRealNumberFirst == true)
-									product = RealOperandNumFirst * realPtr->get_value();
-								else if (boolNumberFirst == true)
-								{
-									Real::value_type valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-									Token::pointer_type realNumber = make<Real>(valueFirst);
-									valueFirst = get_value<Real>(realNumber);
-									product = valueFirst * realPtr->get_value();
-								}
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-							else if (variableFirst == true && (boolRealNumberSecond == true || boolNumberSecond == true))
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-
-
-								// If both oerands are real numbers than just multiply, else if one is a integer
-								// and one is a real convert the integer to a real number
-								if (boolRealNumberSecond == true)
-									product = RealOperandNumSec * realPtr->get_value();
-								else if (boolNumberSecond == true)
-								{
-									Real::value_type valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-									Token::pointer_type realNumber = make<Real>(valueSecond);
-									valueSecond = get_value<Real>(realNumber);
-									product = valueSecond * realPtr->get_value();
-								}
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-								Real::pointer_type realPtrSecond = dynamic_pointer_cast<Real>(secondVariable->get_value());
-								Real::value_type product = realPtrSecond->get_value() * realPtr->get_value();
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
 
-				// If operator is divison, perform the operation on the operands
-				if (is<Division>(operationPTR))
-				{
-					if ((boolNumberFirst == true || boolRealNumberFirst == true || variableFirst == true) &&
-						(boolNumberSecond == false && boolRealNumberSecond == false && variableSecond == false))
-					{
-						throw exception("Error: Not enough operands.");
-					}
-					if (boolVariables == false)
-					{
-						// If the operands are both Integer's perform the divison on it and push the quotient
-						// onto the stack(vector)
-						if (isReal == false)
-						{
-							Integer::value_type quotient = operandSecNum / operandFirstNum;
-							operandStack.push_back(make<Integer>(quotient));
-							continue;
-						}
-						else if (isReal == true)
-						{
-							// Variables to hold the real number values
-							Real::value_type valueFirst;
-							Real::value_type valueSecond;
-							Real::value_type quotientReal;
-
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the divison operations, and to convert(lexical_cast) the
-								// operand numbers to be able to use divison;
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								quotientReal = valueSecond / RealOperandNumFirst;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(quotientReal));
-								continue;
-							}
-							else if (boolNumberFirst == true && boolRealNumberSecond == true)
-							{
-								// Variables to hold the result of the divison operations, and to convert(lexical_cast) the
-								// operand numbers to be able to use divison;
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								quotientReal = RealOperandNumSec / valueFirst;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(quotientReal));
-								continue;
-							}
-							else
-							{
-								// Variables to hold the result of the divison operations, and to convert(lexical_cast) the
-								// operand numbers to be able to divison;
-								quotientReal = RealOperandNumSec / RealOperandNumFirst;
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(quotientReal));
-								continue;
-							}
-						}
-					}
-					else if (boolVariables == true)
-					{
-						if (isReal == false)
-						{ //*****
-							if (boolNumberFirst == true && variableSecond == true)
-							{
-								Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(secondVariable->get_value());
-								Integer::value_type product = integerPtr->get_value() / operandFirstNum;
-								operandStack.push_back(make<Integer>(product));
-								evaluated = true;
-								continue;
-							}
-							else if (boolNumberSecond == true && variableFirst == true)
-							{
-								Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(variable->get_value());
-								Integer::value_type product = operandSecNum / integerPtr->get_value();
-								operandStack.push_back(make<Integer>(product));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							// Variables to hold the real number values
-							Real::value_type product;
-
-							if ((boolRealNumberFirst == true || boolNumberFirst == true) && variableSecond == true)
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to use the multiply								
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(secondVariable->get_value());
-
-								// If both oerands are real numbers than just multiply, else if one is a integer
-								// and one is a real convert the integer to a real number
-								if (boolRealNumberFirst == true)
-									product = realPtr->get_value() / RealOperandNumFirst;
-								else if (boolNumberFirst == true)
-								{
-									Real::value_type valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-									Token::pointer_type realNumber = make<Real>(valueFirst);
-									valueFirst = get_value<Real>(realNumber);
-									product = realPtr->get_value() / valueFirst;
-								}
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-							else if (variableFirst == true && (boolRealNumberSecond == true || boolNumberSecond == true))
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-
-
-								// If both oerands are real numbers than just multiply, else if one is a integer
-								// and one is a real convert the integer to a real number
-								if (boolRealNumberSecond == true)
-									product = RealOperandNumSec * realPtr->get_value();
-								else if (boolNumberSecond == true)
-								{
-									Real::value_type valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-									Token::pointer_type realNumber = make<Real>(valueSecond);
-									valueSecond = get_value<Real>(realNumber);
-									product = valueSecond * realPtr->get_value();
-								}
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-								// operand numbers to be able to multiply
-								Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-								Real::pointer_type realPtrSecond = dynamic_pointer_cast<Real>(secondVariable->get_value());
-								Real::value_type product = realPtrSecond->get_value() * realPtr->get_value();
-
-								// Push the result onto the operands stack(vector)
-								operandStack.push_back(make<Real>(product));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
+	// Function kernels
+	// ================
+	template <typename REAL>
+	void k_abs(value<REAL>* args) {
+		numeric_unary(args, "Abs",
+			[](small_type v, small_type& r) { if (v == SMALL_MIN) return false; r = v < 0 ? -v : v; return true; },
+			[](Integer::value_type const& v) -> Integer::value_type { return abs(v); },
+			[](REAL const& v) -> REAL { return abs(v); });
+	}
 
-				// If operator is modulus, perform the operation on the operands
-				if (is<Modulus>(operationPTR))
-				{
-					if (boolVariables == false)
-					{
-						// If the operands are both Integer's perform the modulus on it and push the reslt
-						// onto the stack(vector)
-						if (isReal == false)
-						{
-							Integer::value_type modulus = operandSecNum % operandFirstNum;
-							operandStack.push_back(make<Integer>(modulus));
-							evaluated = true;
-							continue;
-						}
-						else if (isReal == true)
-						{
-							throw exception("Error: cannot perform <Modulus>");
-						}
-					}
-					else if (boolVariables == true)
-					{
-						// If the operands are both Integer's perform the modulus on it and push the reslt
-						// onto the stack(vector)
-						if (isReal == false)
-						{
-							Integer::value_type modulus;
-
-							if (boolNumberFirst == true)
-							{
-								if (Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(secondVariable->get_value()))
-								{
-									modulus = intPtr->get_value() % operandFirstNum;
-									operandStack.push_back(make<Integer>(modulus));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (boolNumberSecond == true)
-							{
-								if (Integer::pointer_type intPtr = dynamic_pointer_cast<Integer>(variable->get_value()))
-								{
-									modulus = operandSecNum & intPtr->get_value();
-									operandStack.push_back(make<Integer>(modulus));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-						else if (isReal == true)
-						{
-							throw exception("Error: cannot perform <Modulus>");
-						}
-					}
-				}
-			
-
-					if (is<Addition>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// If the operands are both Integer's perform the addition on it and push the result
-								// onto the stack(vector)
-							if (isReal == false)
-							{
-								Integer::value_type result = operandFirstNum + operandSecNum;
-								operandStack.push_back(make<Integer>(result));
-								evaluated = true;
-								continue;
-							}
-							else if (isReal == true)
-							{
-								Real::value_type resultReal;
-								Real::value_type valueFirst;
-								Real::value_type valueSecond;
-
-								if (boolRealNumberFirst == true && boolNumberSecond == true)
-								{
-									// Variables to hold the result of the addition operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use addition properly;
-									valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-									Token::pointer_type realNumber = make<Real>(valueSecond);
-									valueSecond = get_value<Real>(realNumber);
-
-									resultReal = valueSecond + RealOperandNumFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-								else if (boolNumberFirst == true && boolRealNumberSecond == true)
-								{
-									// Variables to hold the result of the addition operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use addition properly;
-									valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-									Token::pointer_type realNumber = make<Real>(valueFirst);
-									valueFirst = get_value<Real>(realNumber);
-
-									resultReal = RealOperandNumSec + valueFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									// Variables to hold the result of the addition operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use addition properly;
-									resultReal = RealOperandNumSec + RealOperandNumFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-						else if (boolVariables == true)
-						{
-							if (isReal == false)
-							{
-								if (boolNumberFirst == true && variableSecond == true)
-								{
-									Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(secondVariable->get_value());
-									Integer::value_type product = operandFirstNum + integerPtr->get_value();
-									operandStack.push_back(make<Integer>(product));
-									evaluated = true;
-									continue;
-								}
-								else if (boolNumberSecond == true && variableFirst == true)
-								{
-									Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(variable->get_value());
-									Integer::value_type product = operandSecNum + integerPtr->get_value();
-									operandStack.push_back(make<Integer>(product));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (isReal == true)
-							{
-								// Variables to hold the real number values
-								Real::value_type productReal;
-								Real::value_type product;
-
-								if ((boolRealNumberFirst == true || boolNumberFirst == true) && variableSecond == true)
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use the multiply								
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(secondVariable->get_value());
-
-									// If both oerands are real numbers than just multiply, else if one is a integer
-									// and one is a real convert the integer to a real number
-									if (boolRealNumberFirst == true)
-										product = realPtr->get_value() + RealOperandNumFirst;
-									else if (boolNumberFirst == true)
-									{
-										Real::value_type valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-										Token::pointer_type realNumber = make<Real>(valueFirst);
-										valueFirst = get_value<Real>(realNumber);
-										product = realPtr->get_value() + valueFirst;
-									}
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-								else if (variableFirst == true && (boolRealNumberSecond == true || boolNumberSecond == true))
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to multiply
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-
-									// If both oerands are real numbers than just multiply, else if one is a integer
-									// and one is a real convert the integer to a real number
-									if (boolRealNumberSecond == true)
-										product = RealOperandNumSec + realPtr->get_value();
-									else if (boolNumberSecond == true)
-									{
-										Real::value_type valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-										Token::pointer_type realNumber = make<Real>(valueSecond);
-										valueSecond = get_value<Real>(realNumber);
-										product = valueSecond + realPtr->get_value();
-									}
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to multiply
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-									Real::pointer_type realPtrSecond = dynamic_pointer_cast<Real>(secondVariable->get_value());
-									Real::value_type product = realPtrSecond->get_value() + realPtr->get_value();
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-					}
+	template <typename REAL>
+	void k_arccos(value<REAL>* args) { real_unary(args, "Arccos", [](REAL const& v) -> REAL { return acos(v); }); }
+	template <typename REAL>
+	void k_arcsin(value<REAL>* args) { real_unary(args, "Arcsin", [](REAL const& v) -> REAL { return asin(v); }); }
+	template <typename REAL>
+	void k_arctan(value<REAL>* args) { real_unary(args, "Arctan", [](REAL const& v) -> REAL { return atan(v); }); }
+	template <typename REAL>
+	void k_ceil(value<REAL>* args) { real_unary(args, "Ceil", [](REAL const& v) -> REAL { return ceil(v); }); }
+	template <typename REAL>
+	void k_cos(value<REAL>* args) { real_unary(args, "Cos", [](REAL const& v) -> REAL { return cos(v); }); }
+	template <typename REAL>
+	void k_exp(value<REAL>* args) { real_unary(args, "Exp", [](REAL const& v) -> REAL { return exp(v); }); }
+	template <typename REAL>
+	void k_floor(value<REAL>* args) { real_unary(args, "Floor", [](REAL const& v) -> REAL { return floor(v); }); }
+	template <typename REAL>
+	void k_lb(value<REAL>* args) { real_unary(args, "Lb", [](REAL const& v) -> REAL { return log2(v); }); }
+	template <typename REAL>
+	void k_ln(value<REAL>* args) { real_unary(args, "Ln", [](REAL const& v) -> REAL { return log(v); }); }
+	template <typename REAL>
+	void k_log(value<REAL>* args) { real_unary(args, "Log", [](REAL const& v) -> REAL { return log10(v); }); }
+	template <typename REAL>
+	void k_sin(value<REAL>* args) { real_unary(args, "Sin", [](REAL const& v) -> REAL { return sin(v); }); }
+	template <typename REAL>
+	void k_sqrt(value<REAL>* args) { real_unary(args, "Sqrt", [](REAL const& v) -> REAL { return sqrt(v); }); }
+	template <typename REAL>
+	void k_tan(value<REAL>* args) { real_unary(args, "Tan", [](REAL const& v) -> REAL { return tan(v); }); }
+
+	/*! Result: replaces a result number with that result of the history.
+		It reads the evaluator's history, so it is called by execute() rather than through the kernel table. */
+	template <typename REAL>
+	void recall(value<REAL>* args, ResultHistory const* history) {
+		dereference(args[0]);
+		if (args[0].index() != V_SMALL)
+			cannot_perform("Result");
+		if (!history)
+			throw exception("Error: there are no results");
+
+		ResultHistory::value_type result = history->get(get<V_SMALL>(args[0]));
+		if (bool const* b = get_if<bool>(&result))
+			args[0].template emplace<V_BOOLEAN>(*b);
+		else if (small_type const* i = get_if<small_type>(&result))
+			args[0].template emplace<V_SMALL>(*i);
+		else if (Integer::value_type* i = get_if<Integer::value_type>(&result))
+			args[0].template emplace<V_BIG>(move(*i));
+		else
+			args[0].template emplace<V_REAL>(static_cast<REAL>(get<Real::value_type>(result)));
+	}
 
-					if (is<Subtraction>(operationPTR))
-					{
-						if ((boolNumberFirst == true || boolRealNumberFirst == true || variableFirst == true) &&
-							(boolNumberSecond == false && boolRealNumberSecond == false && variableSecond == false))
-						{
-							throw exception("Error: Not enough operands.");
-						}
-
-						if (boolVariables == false)
-						{
-							// If the operands are both Integer's perform the subtraction on it and push the result
-								// onto the stack(vector)
-							if (isReal == false)
-							{
-								Integer::value_type result = operandSecNum - operandFirstNum;
-								operandStack.push_back(make<Integer>(result));
-								evaluated = true;
-								continue;
-							}
-							else if (isReal == true)
-							{
-								Real::value_type resultReal;
-								Real::value_type valueFirst;
-								Real::value_type valueSecond;
-
-								if (boolRealNumberFirst == true && boolNumberSecond == true)
-								{
-									// Variables to hold the result of the subtraction operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use subtraction properly;
-									valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-									Token::pointer_type realNumber = make<Real>(valueSecond);
-									valueSecond = get_value<Real>(realNumber);
-
-									resultReal = valueSecond - RealOperandNumFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-								else if (boolNumberFirst == true && boolRealNumberSecond == true)
-								{
-									// Variables to hold the result of the addition operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use addition properly;
-									valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-									Token::pointer_type realNumber = make<Real>(valueFirst);
-									valueFirst = get_value<Real>(realNumber);
-
-									resultReal = RealOperandNumSec - valueFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									// Variables to hold the result of the addition operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use addition properly;
-									resultReal = RealOperandNumSec - RealOperandNumFirst;
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(resultReal));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-						else if (boolVariables == true)
-						{
-							if (isReal == false)
-							{ //*****
-								if (boolNumberFirst == true && variableSecond == true)
-								{
-									Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(secondVariable->get_value());
-									Integer::value_type product = operandFirstNum - integerPtr->get_value();
-									operandStack.push_back(make<Integer>(product));
-									evaluated = true;
-									continue;
-								}
-								else if (boolNumberSecond == true && variableFirst == true)
-								{
-									Integer::pointer_type integerPtr = dynamic_pointer_cast<Integer>(variable->get_value());
-									Integer::value_type product = operandSecNum - integerPtr->get_value();
-									operandStack.push_back(make<Integer>(product));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (isReal == true)
-							{
-								// Variables to hold the real number values
-								Real::value_type productReal;
-								Real::value_type product;
-
-								if ((boolRealNumberFirst == true || boolNumberFirst == true) && variableSecond == true)
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to use the multiply								
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(secondVariable->get_value());
-
-									// If both oerands are real numbers than just multiply, else if one is a integer
-									// and one is a real convert the integer to a real number
-									if (boolRealNumberFirst == true)
-										product = realPtr->get_value() + RealOperandNumFirst;
-									else if (boolNumberFirst == true)
-									{
-										Real::value_type valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-										Token::pointer_type realNumber = make<Real>(valueFirst);
-										valueFirst = get_value<Real>(realNumber);
-										product = realPtr->get_value() + valueFirst;
-									}
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-								else if (variableFirst == true && (boolRealNumberSecond == true || boolNumberSecond == true))
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to multiply
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-
-									// If both oerands are real numbers than just multiply, else if one is a integer
-									// and one is a real convert the integer to a real number
-									if (boolRealNumberSecond == true)
-										product = RealOperandNumSec * realPtr->get_value();
-									else if (boolNumberSecond == true)
-									{
-										Real::value_type valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-										Token::pointer_type realNumber = make<Real>(valueSecond);
-										valueSecond = get_value<Real>(realNumber);
-										product = valueSecond * realPtr->get_value();
-									}
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-									// operand numbers to be able to multiply
-									Real::pointer_type realPtr = dynamic_pointer_cast<Real>(variable->get_value());
-									Real::pointer_type realPtrSecond = dynamic_pointer_cast<Real>(secondVariable->get_value());
-									Real::value_type product = realPtrSecond->get_value() - realPtr->get_value();
-
-									// Push the result onto the operands stack(vector)
-									operandStack.push_back(make<Real>(product));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-					}
-				
-
-				// If comparing Boolean values
-				if (is<Or>(operationPTR) || is<Xor>(operationPTR) || is<And>(operationPTR))
-				{
-					if (is<And>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// Check the boolean values, both must be true to return true,
-							// push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-						}
-					}
+	template <typename REAL>
+	void k_arctan2(value<REAL>* args) {
+		dereference(args[0]);
+		dereference(args[1]);
+		if (!is_numeric(args[0]) || !is_numeric(args[1]))
+			cannot_perform("Arctan2");
+		args[0].template emplace<V_REAL>(REAL(atan2(real_of(args[0]), real_of(args[1]))));
+	}
 
-					if (is<Nand>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// Check the boolean values, both must be true to return false,
-							// push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-						}
-					}
+	template <typename REAL>
+	void k_max(value<REAL>* args) {
+		numeric_binary(args, "Max",
+			[](small_type l, small_type r, small_type& m) { m = l < r ? r : l; return true; },
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return l < r ? r : l; },
+			[](REAL const& l, REAL const& r) -> REAL { return l < r ? r : l; });
+	}
 
-					if (is<Nor>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// Check the boolean values, both must be false to return true,
-							// push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-						}
-					}
+	template <typename REAL>
+	void k_min(value<REAL>* args) {
+		numeric_binary(args, "Min",
+			[](small_type l, small_type r, small_type& m) { m = r < l ? r : l; return true; },
+			[](Integer::value_type const& l, Integer::value_type const& r) -> Integer::value_type { return r < l ? r : l; },
+			[](REAL const& l, REAL const& r) -> REAL { return r < l ? r : l; });
+	}
 
-					if (is<Or>(operationPTR))
-					{
-						if (isBoolValue == true)
-						{
-							// Check the boolean values, one must be true to return true,
-							// push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-						}
-					}
+	template <typename REAL>
+	void k_pow(value<REAL>* args) { power(args, "Pow"); }
+
+
+
+	/*! A kernel table, indexed by operation id. */
+	template <typename REAL>
+	using kernel_table_type = array<kernel_type<REAL>, OP_COUNT>;
+
+	template <typename REAL>
+	kernel_table_type<REAL> make_kernel_table() {
+		kernel_table_type<REAL> table{};
+		table[OP_POWER] = k_power<REAL>;
+		table[OP_ASSIGNMENT] = k_assignment<REAL>;
+		table[OP_ADDITION] = k_addition<REAL>;
+		table[OP_AND] = k_and<REAL>;
+		table[OP_DIVISION] = k_division<REAL>;
+		table[OP_EQUALITY] = k_equality<REAL>;
+		table[OP_GREATER] = k_greater<REAL>;
+		table[OP_GREATER_EQUAL] = k_greater_equal<REAL>;
+		table[OP_INEQUALITY] = k_inequality<REAL>;
+		table[OP_LESS] = k_less<REAL>;
+		table[OP_LESS_EQUAL] = k_less_equal<REAL>;
+		table[OP_MULTIPLICATION] = k_multiplication<REAL>;
+		table[OP_MODULUS] = k_modulus<REAL>;
+		table[OP_NAND] = k_nand<REAL>;
+		table[OP_NOR] = k_nor<REAL>;
+		table[OP_OR] = k_or<REAL>;
+		table[OP_SUBTRACTION] = k_subtraction<REAL>;
+		table[OP_XOR] = k_xor<REAL>;
+		table[OP_XNOR] = k_xnor<REAL>;
+		table[OP_IDENTITY] = k_identity<REAL>;
+		table[OP_NEGATION] = k_negation<REAL>;
+		table[OP_NOT] = k_not<REAL>;
+		table[OP_FACTORIAL] = k_factorial<REAL>;
+		table[OP_ABS] = k_abs<REAL>;
+		table[OP_ARCCOS] = k_arccos<REAL>;
+		table[OP_ARCSIN] = k_arcsin<REAL>;
+		table[OP_ARCTAN] = k_arctan<REAL>;
+		table[OP_CEIL] = k_ceil<REAL>;
+		table[OP_COS] = k_cos<REAL>;
+		table[OP_EXP] = k_exp<REAL>;
+		table[OP_FLOOR] = k_floor<REAL>;
+		table[OP_LB] = k_lb<REAL>;
+		table[OP_LN] = k_ln<REAL>;
+		table[OP_LOG] = k_log<REAL>;
+		table[OP_SIN] = k_sin<REAL>;
+		table[OP_SQRT] = k_sqrt<REAL>;
+		table[OP_TAN] = k_tan<REAL>;
+		table[OP_ARCTAN2] = k_arctan2<REAL>;
+		table[OP_MAX] = k_max<REAL>;
+		table[OP_MIN] = k_min<REAL>;
+		table[OP_POW] = k_pow<REAL>;
+		return table;
+	}
 
-					if (is<Xor>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// Check the boolean values, one must be true and one must be false
-							// to return true, push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					if (is<Xnor>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							// Check the boolean values, one must be true and one must be false
-							// to return true, push result onto operands stack(vector)
-							if (firstBool == true && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == true && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == false)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolVariables == true)
-						{
-							Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-							Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-							if (boolPtr->get_value() == true && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == true)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == true && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-							else if (boolPtr->get_value() == false && boolSecondPtr->get_value() == false)
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-
-								if (operandStack.size() > 0)
-									operandStack.push_back(variable);
-								else if (operandStack.size() == 0)
-								{
-									operandStack.push_back(newBoolValue);
-								}
-
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
+	/*! The kernel table of a precision tier. */
+	template <typename REAL>
+	kernel_table_type<REAL> const& kernel_table() {
+		static kernel_table_type<REAL> const table = make_kernel_table<REAL>();
+		return table;
+	}
 
-				if (is<Equality>(operationPTR))
-				{
-					Real::value_type resultReal;
-					Real::value_type valueFirst;
-					Real::value_type valueSecond;
-
-					if (isBoolValue == true)
-					{
-						// Check the boolean values, both must be the same value 
-						// to return true, push result onto operands stack(vector)
-						if ((firstBool == true && secondBool == true) || (firstBool == false && secondBool == false))
-						{
-							operandStack.push_back(make<Boolean>(true));
-							evaluated = true;
-							continue;
-						}
-						else if (firstBool == false || secondBool == false)
-						{
-							operandStack.push_back(make<Boolean>(false));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == false && boolVariables == false)
-					{
-						if (operandFirstNum == operandSecNum)
-						{
-							operandStack.push_back(make<Boolean>(true));
-							evaluated = true;
-							continue;
-						}
-						else if (operandFirstNum != operandSecNum)
-						{
-							operandStack.push_back(make<Boolean>(false));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == true)
-					{
-						if (boolRealNumberFirst == true && boolNumberSecond == true)
-						{
-							// Variables to hold the result of the equality operation, and to convert(lexical_cast) the
-							// operand numbers to be able to use the equality operation;
-							valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-							Token::pointer_type realNumber = make<Real>(valueSecond);
-							valueSecond = get_value<Real>(realNumber);
-
-							if (RealOperandNumFirst == valueSecond)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (boolRealNumberSecond == true && boolNumberFirst == true)
-						{
-							// Variables to hold the result of the equality operation, and to convert(lexical_cast) the
-							// operand numbers to be able to use the equality operation;
-							valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-							Token::pointer_type realNumber = make<Real>(valueFirst);
-							valueFirst = get_value<Real>(realNumber);
-
-							if (valueFirst == RealOperandNumSec)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (RealOperandNumFirst == RealOperandNumSec)
-						{
-							operandStack.push_back(make<Boolean>(true));
-							evaluated = true;
-							continue;
-						}
-						else
-						{
-							operandStack.push_back(make<Boolean>(false));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (boolVariables == true)
-					{
-						Boolean::pointer_type boolPtr = nullptr;
-						Boolean::pointer_type boolSecondPtr = nullptr;
-
-						if (variableFirst == true)
-							boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-						if (variableSecond == true)
-							boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-						if (variableFirst == true && variableSecond == true)
-						{
-							if ((boolPtr->get_value() == true && boolSecondPtr->get_value() == true) ||
-								(boolPtr->get_value() == false && boolSecondPtr->get_value() == false))
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (variableFirst == true && secondBool == true)
-						{
-							if ((boolPtr->get_value() == true && secondBool == true) ||
-								(boolPtr->get_value() == false && secondBool == false))
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (variableSecond == true && firstBool == true)
-						{
-							if ((boolSecondPtr->get_value() == true && firstBool == true) ||
-								(boolSecondPtr->get_value() == false && firstBool == false))
-							{
-								Token::pointer_type boolToken = make<Boolean>(true);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								Token::pointer_type boolToken = make<Boolean>(false);
-								Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-								variable->set_value(newBoolValue);
-								operandStack.push_back(variable);
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
 
-				if (is<Inequality>(operationPTR))
-				{
-					// Variables to hold the lexical_cast numbers
-					Real::value_type resultReal;
-					Real::value_type valueFirst;
-					Real::value_type valueSecond;
-
-					if (boolVariables == false)
-					{
-						if (isBoolValue == true)
-						{
-							// Check the boolean values, both must be the same value 
-							// to return true, push result onto operands stack(vector)
-							if ((firstBool == true && secondBool == true) || (firstBool == false && secondBool == false))
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if ((firstBool == false && secondBool == true) || (firstBool == true && secondBool == false))
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == false)
-						{
-							if (operandFirstNum != operandSecNum)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (operandFirstNum == operandSecNum)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the inequality operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the inequality operation;
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								if (RealOperandNumFirst != valueSecond)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (boolRealNumberSecond == true && boolNumberFirst == true)
-							{
-								// Variables to hold the result of the inequality operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the inequality operation;
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								if (valueFirst != RealOperandNumSec)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (RealOperandNumFirst != RealOperandNumSec)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					else if (boolVariables == true)
-					{
-						Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-						Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-						if ((boolPtr->get_value() == true && boolSecondPtr->get_value() == true) ||
-							(boolPtr->get_value() == false && boolSecondPtr->get_value() == false))
-						{
-							Token::pointer_type boolToken = make<Boolean>(false);
-							Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-							variable->set_value(newBoolValue);
-							operandStack.push_back(variable);
-							evaluated = true;
-							continue;
-						}
-						else
-						{
-							Token::pointer_type boolToken = make<Boolean>(true);
-							Boolean::pointer_type newBoolValue = dynamic_pointer_cast<Boolean>(boolToken);
-							variable->set_value(newBoolValue);
-							operandStack.push_back(variable);
-							evaluated = true;
-							continue;
-						}
-					}
-				}
 
-				// If the boolean values are being related to eachother >, <, <=, >=
-				// Variables to hold the lexical_cast numbers
-					Real::value_type resultReal;
-					Real::value_type valueFirst;
-					Real::value_type valueSecond;
-
-					// Returns true only when user inputs true > false, or a value1 > value2
-					if (is<Greater>(operationPTR))
-					{
-						if (boolVariables == false)
-						{
-							if (isBoolValue == true)
-							{
-								if ((firstBool == true && secondBool == true) || (firstBool == false && secondBool == false)
-									|| (firstBool == true && secondBool == false))
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (isReal == false)
-							{
-								// check the integer values are greater than
-								if (operandSecNum > operandFirstNum)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (isReal == true)
-							{
-								if (boolRealNumberFirst == true && boolNumberSecond == true)
-								{
-									// Variables to hold the result of the greater than operation, and to convert(lexical_cast) the
-									// operand numbers to be able to use the greater than operation;
-									valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-									Token::pointer_type realNumber = make<Real>(valueSecond);
-									valueSecond = get_value<Real>(realNumber);
-
-									if (valueSecond > RealOperandNumFirst)
-									{
-										operandStack.push_back(make<Boolean>(true));
-										evaluated = true;
-										continue;
-									}
-									else
-									{
-										operandStack.push_back(make<Boolean>(false));
-										evaluated = true;
-										continue;
-									}
-								}
-								else if (boolRealNumberSecond == true && boolNumberFirst == true)
-								{
-									// Variables to hold the result of the greater than operation, and to convert(lexical_cast) the
-									// operand numbers to be able to use the greater than operation;
-									valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-									Token::pointer_type realNumber = make<Real>(valueFirst);
-									valueFirst = get_value<Real>(realNumber);
-
-									if (RealOperandNumSec > valueFirst)
-									{
-										operandStack.push_back(make<Boolean>(true));
-										evaluated = true;
-										continue;
-									}
-									else
-									{
-										operandStack.push_back(make<Boolean>(false));
-										evaluated = true;
-										continue;
-									}
-								}
-								else if (RealOperandNumSec > RealOperandNumFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-						if (boolVariables == true)
-						{
-							if (isBoolValue == true)
-							{
-								Boolean::pointer_type boolPtr = dynamic_pointer_cast<Boolean>(variable->get_value());
-								Boolean::pointer_type boolSecondPtr = dynamic_pointer_cast<Boolean>(secondVariable->get_value());
-
-								if ((firstBool == true && boolSecondPtr->get_value() == true) || (firstBool == false && boolSecondPtr->get_value() == false)
-									|| (firstBool == true && boolSecondPtr->get_value() == false) || (secondBool == true && boolPtr->get_value() == true)
-									|| (secondBool == false && boolPtr->get_value() == false) || (secondBool == false && boolPtr->get_value() == true))
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-							}
-						}
-					}
-					else if (is<GreaterEqual>(operationPTR))
-					{
-						// Check if the boolean values are greater than or equal to each other(true is > than false)
-						if (isBoolValue == true)
-						{
-							if ((firstBool == true && secondBool == true) || (secondBool == true && firstBool == false)
-								|| (secondBool == false && firstBool == false))
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == false)
-						{
-							// check the integer values are greater than or equal
-							if (operandSecNum >= operandFirstNum)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the inequality operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the inequality operation;
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								if (valueSecond >= RealOperandNumFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (boolRealNumberSecond == true && boolNumberFirst == true)
-							{
-								// Variables to hold the result of the inequality operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the inequality operation;
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								if (RealOperandNumSec >= valueFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (RealOperandNumSec >= RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					else if (is<Less>(operationPTR))
-					{
-						if (isBoolValue == true)
-						{
-							// Check the boolean values if they are less than. Only false is less than true
-							if ((firstBool == true && secondBool == true) || (firstBool == false && secondBool == true)
-								|| (firstBool == false && secondBool == false))
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-							else if (secondBool == false && firstBool == true)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == false)
-						{
-							// check the integer values are less than
-							if (operandSecNum < operandFirstNum)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the less than operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the less than operation;
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								if (valueSecond < RealOperandNumFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (boolRealNumberSecond == true && boolNumberFirst == true)
-							{
-								// Variables to hold the result of the less than operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the less than operation;
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								if (RealOperandNumSec < valueFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (RealOperandNumSec < RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-					else if (is<LessEqual>(operationPTR))
-					{
-						if (isBoolValue == true)
-						{
-							if ((secondBool == false && firstBool == true) || (firstBool == false && secondBool == false)
-								|| (firstBool == true && secondBool == true))
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else if (firstBool == false && secondBool == true)
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == false)
-						{
-							// check the integer values are less than or equal
-							if (operandSecNum <= operandFirstNum)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-						else if (isReal == true)
-						{
-							if (boolRealNumberFirst == true && boolNumberSecond == true)
-							{
-								// Variables to hold the result of the less than or equal to operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the less than or equal to operation;
-								valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-								Token::pointer_type realNumber = make<Real>(valueSecond);
-								valueSecond = get_value<Real>(realNumber);
-
-								if (valueSecond <= RealOperandNumFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (RealOperandNumSec > 0.0 && operandFirstNum > 0)
-							{
-								// Variables to hold the result of the less than or equal to operation, and to convert(lexical_cast) the
-								// operand numbers to be able to use the less than or equal to operation;
-								valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-								Token::pointer_type realNumber = make<Real>(valueFirst);
-								valueFirst = get_value<Real>(realNumber);
-
-								if (RealOperandNumSec <= valueFirst)
-								{
-									operandStack.push_back(make<Boolean>(true));
-									evaluated = true;
-									continue;
-								}
-								else
-								{
-									operandStack.push_back(make<Boolean>(false));
-									evaluated = true;
-									continue;
-								}
-							}
-							else if (RealOperandNumSec <= RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Boolean>(true));
-								evaluated = true;
-								continue;
-							}
-							else
-							{
-								operandStack.push_back(make<Boolean>(false));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
-			
-			// Check if the operation is a function
-			
-			if (is<Function>(operationPTR))
-			{
-				// If it is Absolute value perform the operation on it.
-				if (is<Abs>(operationPTR))
-				{
-					if (isReal == false)
-					{
-						if (operandFirstNum > 0)
-						{
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
-						else if (operandFirstNum < 0)
-						{
-							operandFirstNum *= -1;
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == true)
-					{
-						if (RealOperandNumFirst > 0)
-						{
-							operandStack.push_back(make<Real>(RealOperandNumFirst));
-							evaluated = true;
-							continue;
-						}
-						else if (RealOperandNumFirst < 0)
-						{
-							RealOperandNumFirst *= -1.0;
-							operandStack.push_back(make<Real>(RealOperandNumFirst));
-							evaluated = true;
-							continue;
-						}
-					}
-				}				
-				else if (is<Arccos>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = acos(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Arcsin>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = asin(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Arctan>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = atan(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Ceil>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = ceil(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Cos>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = cos(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Exp>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = exp(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Floor>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = floor(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Lb>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = log2(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Ln>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = log10(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Sin>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = sin(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Sqrt>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = sqrt(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Sin>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						//double tempFirstNum = boost::lexical_cast<double>(RealOperandNumFirst);
-						Real::value_type result = sin(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Tan>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = tan(RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Arctan2>(operationPTR))
-				{
-					if (isReal == true)
-					{
-						// Variable to hold the cast value and the returned value from the acos function
-						Real::value_type result = atan2(RealOperandNumSec, RealOperandNumFirst);
-
-						// Push result onto the operands stack(vector)
-						operandStack.push_back(make<Real>(result));
-						evaluated = true;
-						continue;
-					}
-				}
-				else if (is<Max>(operationPTR))
-				{
-					// Variables to hold the lexical_cast numbers
-					Real::value_type resultReal;
-					Real::value_type valueFirst;
-					Real::value_type valueSecond;
-
-					if (boolNumberFirst == true)
-					{
-						// Convert the first number to a real to be able to compare then values
-						valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-						Token::pointer_type realNumber = make<Real>(valueFirst);
-						valueFirst = get_value<Real>(realNumber);
-					}
+	/*! Runs a program on a stack of unboxed values, which must hold the program's maximum depth.
+		'pushVariable' pushes the value of the Variable at a constant pool index.  Result reads 'history'.
+		@return the result, at the bottom of the stack. */
+	template <typename REAL, typename PUSH_VARIABLE>
+	value<REAL>& execute(Program const& program, vector<value<REAL>>& operandStack, ResultHistory const* history, PUSH_VARIABLE pushVariable) {
+		kernel_table_type<REAL> const& kernelTable = kernel_table<REAL>();
+		Program::constant_pool_type const& constants = program.get_constants();
+		Program::code_type const& code = program.get_code();
 
-					if (boolNumberSecond == true)
-					{
-						valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-						Token::pointer_type realNumber = make<Real>(valueSecond);
-						valueSecond = get_value<Real>(realNumber);
-					}
+		value<REAL>* top = operandStack.data();
 
+		for (size_t pc = 0; pc < code.size(); ++pc)
+		{
+			Instruction const& instruction = code[pc];
+			switch (instruction.opcode) {
+			case OPC_PUSH_SMALL:
+				(top++)->template emplace<V_SMALL>(instruction.immediate);
+				break;
+			case OPC_PUSH_BOOLEAN:
+				(top++)->template emplace<V_BOOLEAN>(instruction.immediate != 0);
+				break;
+			case OPC_PUSH_PI:
+				(top++)->template emplace<V_REAL>(real_constants<REAL>::pi());
+				break;
+			case OPC_PUSH_E:
+				(top++)->template emplace<V_REAL>(real_constants<REAL>::e());
+				break;
+			case OPC_PUSH_CONSTANT:
+				*top++ = unbox<REAL>(constants[size_t(instruction.immediate)]);
+				break;
+			case OPC_PUSH_VARIABLE:
+				pushVariable(*top++, size_t(instruction.immediate));
+				break;
+			case OPC_CALL:
+				top -= instruction.argCount;
+				if (instruction.operation == OP_RESULT)
+					recall(top, history);
+				else
+					kernelTable[instruction.operation](top);
+				++top;
+				break;
+			case OPC_SHORT_CIRCUIT:
+				if (short_circuit(top[-1], instruction.operation))
+					pc = size_t(instruction.immediate);
+				break;
+			}
+		}
 
-					if (isReal == false)
-					{
-						if (operandSecNum > operandFirstNum)
-						{
-							operandStack.push_back(make<Integer>(operandSecNum));
-							evaluated = true;
-							continue;
-						}
-						else if (operandFirstNum > operandSecNum)
-						{
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
-						else if (operandSecNum == operandFirstNum)
-						{
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
+		assert(top == operandStack.data() + 1 && "the compiler guarantees a single result");
+		return operandStack.front();
+	}
 
-					}
-					else if (isReal == true)
-					{
-						if (boolRealNumberFirst == true && boolRealNumberSecond == true)
-						{
-							if (RealOperandNumSec > RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumSec < RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumFirst));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumSec == RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-						}
-
-						if (boolRealNumberSecond == true && boolNumberFirst == true)
-						{
-							if (RealOperandNumSec > valueFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumSec < valueFirst)
-							{
-								operandStack.push_back(make<Real>(valueFirst));
-								evaluated = true;
-								continue;
-							}
-							else if (valueFirst == RealOperandNumSec)
-							{
-								operandStack.push_back(make<Real>(valueFirst));
-								evaluated = true;
-								continue;
-							}
-						}
-
-						if (boolNumberSecond == true && boolRealNumberFirst == true)
-						{
-							if (valueSecond > RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(valueSecond));
-								evaluated = true;
-								continue;
-							}
-							else if (valueSecond < RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumFirst));
-								evaluated = true;
-								continue;
-							}
-							else if ((valueSecond == RealOperandNumFirst))
-							{
-								operandStack.push_back(make<Real>(valueSecond));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
-				}
-				else if (is<Min>(operationPTR))
-				{
-					// Variables to hold the lexical_cast numbers
-					Real::value_type resultReal;
-					Real::value_type valueFirst;
-					Real::value_type valueSecond;
-
-					if (boolNumberFirst == true)
-					{
-						// Convert the first number to a real to be able to compare then values
-						valueFirst = boost::lexical_cast<Real::value_type>(operandFirstNum);
-						Token::pointer_type realNumber = make<Real>(valueFirst);
-						valueFirst = get_value<Real>(realNumber);
-					}
 
-					if (boolNumberSecond == true)
-					{
-						// Convert the first number to a real to be able to compare then values
-						valueSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-						Token::pointer_type realNumber = make<Real>(valueSecond);
-						valueSecond = get_value<Real>(realNumber);
-					}
 
-					if (isReal == false)
-					{
-						if (operandSecNum < operandFirstNum)
-						{
-							operandStack.push_back(make<Integer>(operandSecNum));
-							evaluated = true;
-							continue;
-						}
-						else if (operandFirstNum < operandSecNum)
-						{
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
-						else if (operandSecNum == operandFirstNum)
-						{
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
+	/*! Runs a program.  Only the final result is boxed.
+		A non-null 'bindings' entry is pushed in place of the Variable at the same constant pool index. */
+	template <typename REAL>
+	Operand::pointer_type run_with(Program const& program, vector<Operand::pointer_type> const* bindings, Environment* environment, ResultHistory const* history) {
+		Program::constant_pool_type const& constants = program.get_constants();
+		environment_view view(environment);
+		vector<value<REAL>> operandStack(program.get_max_depth());
+		return box(execute<REAL>(program, operandStack, history, [&](value<REAL>& slot, size_t index) {
+			if (bindings && (*bindings)[index])
+				slot = unbox<REAL>((*bindings)[index]);
+			else
+				slot.template emplace<V_VARIABLE>(variable_ref{ &constants[index], &view });
+		}));
+	}
 
-					}
-					else if (isReal == true)
-					{
-						if (boolRealNumberFirst == true && boolRealNumberSecond == true)
-						{
-							if (RealOperandNumSec < RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumSec > RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumFirst));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumSec == RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-						}
-
-						if (boolRealNumberFirst == true && boolNumberSecond == true)
-						{
-							if (RealOperandNumFirst < valueSecond)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumFirst));
-								evaluated = true;
-								continue;
-							}
-							else if (RealOperandNumFirst > valueSecond)
-							{
-								operandStack.push_back(make<Real>(valueSecond));
-								evaluated = true;
-								continue;
-							}
-							else if (valueSecond == RealOperandNumFirst)
-							{
-								operandStack.push_back(make<Real>(valueSecond));
-								evaluated = true;
-								continue;
-							}
-						}
-						if (boolNumberFirst == true && boolRealNumberSecond == true)
-						{
-							if (valueFirst < RealOperandNumSec)
-							{
-								operandStack.push_back(make<Real>(valueFirst));
-								evaluated = true;
-								continue;
-							}
-							else if (valueFirst > RealOperandNumSec)
-							{
-								operandStack.push_back(make<Real>(RealOperandNumSec));
-								evaluated = true;
-								continue;
-							}
-							else if ((valueFirst == RealOperandNumSec))
-							{
-								operandStack.push_back(make<Real>(valueFirst));
-								evaluated = true;
-								continue;
-							}
-						}
-					}
+
+
+	/*! Runs a program once per row, pushing column values in place of the Variables bound to columns. */
+	template <typename REAL>
+	void run_rows(Program const& program, vector<REAL const*> const& columns, size_t rows, REAL* results, Environment* environment, ResultHistory const* history) {
+		Program::constant_pool_type const& constants = program.get_constants();
+		environment_view view(environment);
+		vector<value<REAL>> operandStack(program.get_max_depth());
+		for (size_t row = 0; row < rows; ++row) {
+			value<REAL>& result = execute<REAL>(program, operandStack, history, [&](value<REAL>& slot, size_t index) {
+				if (columns[index])
+					slot.template emplace<V_REAL>(columns[index][row]);
+				else
+					slot.template emplace<V_VARIABLE>(variable_ref{ &constants[index], &view });
+			});
+			dereference(result);
+			if (!is_numeric(result))
+				throw exception("Error: batch result is not a number");
+			results[row] = real_of(result);
+		}
+	}
+
+
+
+	// Column-wise evaluation
+	// ======================
+	/*! Rows evaluated together by each column-wise instruction.
+		The block loops are plain loops: they use SIMD only as far as the build's optimization flags let the compiler
+		vectorize them (e.g. /O2 /arch:AVX2); the project sets no such flags itself. */
+	constexpr size_t BATCH_BLOCK = 256;
+
+	/*! A value of a column-wise evaluation: a block of a column, or one number for every row. */
+	struct column_slot {
+		double const*	data;		// nullptr for a number
+		double			number;
+		bool			isSmall;	// the number is the Integer 'small'
+		small_type		small;
+	};
+
+	/*! Operations that have a column-wise form in the double tier. */
+	bool has_column_form(unsigned short operation) {
+		switch (operation) {
+		case OP_ADDITION: case OP_SUBTRACTION: case OP_MULTIPLICATION: case OP_DIVISION:
+		case OP_IDENTITY: case OP_NEGATION: case OP_ABS: case OP_MAX: case OP_MIN:
+		case OP_POWER: case OP_POW: case OP_ARCTAN2:
+		case OP_ARCCOS: case OP_ARCSIN: case OP_ARCTAN: case OP_CEIL: case OP_COS: case OP_EXP: case OP_FLOOR:
+		case OP_LB: case OP_LN: case OP_LOG: case OP_SIN: case OP_SQRT: case OP_TAN:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/*! Applies an operation whose arguments are all numbers with the double tier's kernel, so a constant sub-expression
+		is broadcast to every row with exactly the value evaluate() gives it.  The result replaces args[0].
+		Returns false unless the result is a small Integer or a Real. */
+	bool apply_numbers(unsigned short operation, column_slot* args, unsigned argCount) {
+		vector<value<double>> values;
+		for (unsigned i = 0; i < argCount; ++i)
+			if (args[i].isSmall)
+				values.emplace_back(in_place_index<V_SMALL>, args[i].small);
+			else
+				values.emplace_back(in_place_index<V_REAL>, args[i].number);
+		kernel_table<double>()[operation](values.data());
+		switch (values.front().index()) {
+		case V_SMALL:	args[0] = { nullptr, real_of(values.front()), true, get<V_SMALL>(values.front()) }; return true;
+		case V_REAL:	args[0] = { nullptr, get<V_REAL>(values.front()), false, 0 }; return true;
+		default:		return false;
+		}
+	}
+
+	/*! Checks that a program can run column-wise: every operation that takes a column has a column form, and every
+		operation of numbers only gives a number, so every row gives exactly what the kernels give. */
+	bool is_columnar(Program const& program, vector<double const*> const& columns) {
+		Program::constant_pool_type const& constants = program.get_constants();
+		vector<column_slot> stack;
+		for (Instruction const& instruction : program.get_code()) {
+			switch (instruction.opcode) {
+			case OPC_PUSH_SMALL:
+				stack.push_back({ nullptr, real_of(value<double>(in_place_index<V_SMALL>, instruction.immediate)), true, instruction.immediate });
+				break;
+			case OPC_PUSH_PI:
+				stack.push_back({ nullptr, real_constants<double>::pi(), false, 0 });
+				break;
+			case OPC_PUSH_E:
+				stack.push_back({ nullptr, real_constants<double>::e(), false, 0 });
+				break;
+			case OPC_PUSH_CONSTANT:
+				if (!is<Real>(constants[size_t(instruction.immediate)]))
+					return false;
+				stack.push_back({ nullptr, get<V_REAL>(unbox<double>(constants[size_t(instruction.immediate)])), false, 0 });
+				break;
+			case OPC_PUSH_VARIABLE:
+				if (!columns[size_t(instruction.immediate)])
+					return false;
+				stack.push_back({ columns[size_t(instruction.immediate)], 0, false, 0 });
+				break;
+			case OPC_CALL: {
+				auto args = stack.end() - instruction.argCount;
+				if (none_of(args, stack.end(), [](column_slot const& s) { return s.data != nullptr; })) {
+					try {
+						if (!apply_numbers(instruction.operation, &*args, instruction.argCount))
+							return false;
+					}
+					catch (...) {
+						return false;	// left for each row to report
+					}
+					stack.erase(args + 1, stack.end());
+					break;
 				}
-				// Check if the operator is the Power operation (2^4) = 16
-				if (is<Pow>(operationPTR))
-				{
-					// Variables to hold the lexical cast numbers
-					Real::value_type resultRealPower;
-					Real::value_type valueRealFirst;
-					Real::value_type valueRealSecond;
-
-					Integer::value_type resultIntegerPower;
-					Integer::value_type valueIntegerFirst;
-					Integer::value_type valueIntegerSecond;
-
-					// Check to see if the operands are only Integers
-					if (isReal == false)
-					{
-						// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-						// operand numbers to be able to use the pow() function;					
-						int powerNumber = boost::lexical_cast<int>(operandFirstNum);
-
-						if (powerNumber < 0)
-						{
-							// Cast the base number to a Real number because if the exponent number(powerNum) is
-							// a negative number then the result will be a Real number
-							valueRealSecond = boost::lexical_cast<Real::value_type>(operandSecNum);
-							Token::pointer_type realNumber = make<Real>(valueRealSecond);
-							valueRealSecond = get_value<Real>(realNumber);
-
-							resultRealPower = boost::multiprecision::pow(valueRealSecond, powerNumber);
-
-							// Push the real number result onto the operand stack(vector)
-							operandStack.push_back(make<Real>(resultRealPower));
-							evaluated = true;
-							continue;
-						}
-						else if (powerNumber > 0)
-						{
-							// Calculate the power
-							resultIntegerPower = boost::multiprecision::pow(operandSecNum, powerNumber);
-
-							// Push the integer Result onto the operand stack(vector)
-							operandStack.push_back(make<Integer>(resultIntegerPower));
-							evaluated = true;
-							continue;
-						}
-						else if (powerNumber == 0)
-						{
-							// Push the integer Result onto the operand stack(vector)
-							operandStack.push_back(make<Integer>(1));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == true)
-					{
-
-						if (boolRealNumberFirst == true && boolNumberSecond == true)
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(RealOperandNumFirst);
-
-							valueRealFirst = boost::lexical_cast<Real::value_type>(operandSecNum);
-							Token::pointer_type realNumber = make<Real>(valueRealFirst);
-							valueRealFirst = get_value<Real>(realNumber);
-
-							Real::value_type realResult = boost::multiprecision::pow(valueRealFirst, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else if (boolNumberFirst == true && boolRealNumberSecond == true)
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(operandFirstNum);
-
-							Real::value_type realResult = pow(RealOperandNumSec, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else if (boolRealNumberSecond == true && boolRealNumberFirst == true)
-						{
-							// Get the result of the power of 2 real numbers
-							Real::value_type realResult = boost::multiprecision::pow(RealOperandNumSec, RealOperandNumFirst);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-						else
-						{
-							// Variables to hold the result of the pow operations, and to convert(lexical_cast) the
-							// operand numbers to be able to use the pow() function;
-							int powerNumber = boost::lexical_cast<int>(RealOperandNumFirst);
-
-							Real::value_type realResult = pow(RealOperandNumSec, powerNumber);
-
-							// Push the result onto the operands stack(vector)
-							operandStack.push_back(make<Real>(realResult));
-							evaluated = true;
-							continue;
-						}
-					}
+				if (!has_column_form(instruction.operation))
+					return false;
+				// an Integer exponent must fit an int
+				if ((instruction.operation == OP_POWER || instruction.operation == OP_POW) && args[1].isSmall
+					&& (args[1].small < numeric_limits<int>::min() || args[1].small > numeric_limits<int>::max()))
+					return false;
+				stack.erase(args + 1, stack.end());
+				args->data = columns.front();	// any non-null pointer: the result is a column
+				args->isSmall = false;
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return stack.size() == 1 && stack.front().data;
+	}
+
+	template <typename FN>
+	inline void map_unary(column_slot const* args, double* out, size_t n, FN fn) {
+		double const* a = args[0].data;
+		for (size_t i = 0; i < n; ++i)
+			out[i] = fn(a[i]);
+	}
+
+	template <typename FN>
+	inline void map_binary(column_slot const* args, double* out, size_t n, FN fn) {
+		double const* a = args[0].data;
+		double const* b = args[1].data;
+		if (a && b)
+			for (size_t i = 0; i < n; ++i)
+				out[i] = fn(a[i], b[i]);
+		else if (a) {
+			double const number = args[1].number;
+			for (size_t i = 0; i < n; ++i)
+				out[i] = fn(a[i], number);
+		}
+		else {
+			double const number = args[0].number;
+			for (size_t i = 0; i < n; ++i)
+				out[i] = fn(number, b[i]);
+		}
+	}
+
+	/*! Applies an operation to a block of rows.  The operations are those of the kernels, on doubles. */
+	void apply_columns(unsigned short operation, column_slot const* args, double* out, size_t n) {
+		switch (operation) {
+		case OP_ADDITION:		map_binary(args, out, n, [](double l, double r) { return l + r; }); break;
+		case OP_SUBTRACTION:	map_binary(args, out, n, [](double l, double r) { return l - r; }); break;
+		case OP_MULTIPLICATION:	map_binary(args, out, n, [](double l, double r) { return l * r; }); break;
+		case OP_DIVISION:		map_binary(args, out, n, [](double l, double r) { return l / r; }); break;
+		case OP_MAX:			map_binary(args, out, n, [](double l, double r) { return l < r ? r : l; }); break;
+		case OP_MIN:			map_binary(args, out, n, [](double l, double r) { return r < l ? r : l; }); break;
+		case OP_ARCTAN2:		map_binary(args, out, n, [](double l, double r) { return atan2(l, r); }); break;
+		case OP_POWER:
+		case OP_POW:
+			if (args[1].isSmall) {
+				double const exponent = double(args[1].small);
+				map_unary(args, out, n, [exponent](double v) { return real_power(v, exponent); });
+			}
+			else
+				map_binary(args, out, n, [](double l, double r) { return real_power(l, r); });
+			break;
+		case OP_IDENTITY:		map_unary(args, out, n, [](double v) { return v; }); break;
+		case OP_NEGATION:		map_unary(args, out, n, [](double v) { return -v; }); break;
+		case OP_ABS:			map_unary(args, out, n, [](double v) { return abs(v); }); break;
+		case OP_ARCCOS:			map_unary(args, out, n, [](double v) { return acos(v); }); break;
+		case OP_ARCSIN:			map_unary(args, out, n, [](double v) { return asin(v); }); break;
+		case OP_ARCTAN:			map_unary(args, out, n, [](double v) { return atan(v); }); break;
+		case OP_CEIL:			map_unary(args, out, n, [](double v) { return ceil(v); }); break;
+		case OP_COS:			map_unary(args, out, n, [](double v) { return cos(v); }); break;
+		case OP_EXP:			map_unary(args, out, n, [](double v) { return exp(v); }); break;
+		case OP_FLOOR:			map_unary(args, out, n, [](double v) { return floor(v); }); break;
+		case OP_LB:				map_unary(args, out, n, [](double v) { return log2(v); }); break;
+		case OP_LN:				map_unary(args, out, n, [](double v) { return log(v); }); break;
+		case OP_LOG:			map_unary(args, out, n, [](double v) { return log10(v); }); break;
+		case OP_SIN:			map_unary(args, out, n, [](double v) { return sin(v); }); break;
+		case OP_SQRT:			map_unary(args, out, n, [](double v) { return sqrt(v); }); break;
+		case OP_TAN:			map_unary(args, out, n, [](double v) { return tan(v); }); break;
+		}
+	}
+
+	/*! Runs a columnar program a block of rows at a time.
+		Each instruction on a column is a tight loop over a block; an instruction on numbers only is applied once. */
+	void run_columns(Program const& program, vector<double const*> const& columns, size_t rows, double* results) {
+		Program::constant_pool_type const& constants = program.get_constants();
+		Program::code_type const& code = program.get_code();
+		size_t const depth = program.get_max_depth();
+
+		vector<double> blocks(depth * BATCH_BLOCK);
+		vector<column_slot> stack(depth);
+
+		for (size_t first = 0; first < rows; first += BATCH_BLOCK) {
+			size_t const n = min(BATCH_BLOCK, rows - first);
+			column_slot* top = stack.data();
+			for (Instruction const& instruction : code) {
+				switch (instruction.opcode) {
+				case OPC_PUSH_SMALL:
+					*top++ = { nullptr, real_of(value<double>(in_place_index<V_SMALL>, instruction.immediate)), true, instruction.immediate };
+					break;
+				case OPC_PUSH_PI:
+					*top++ = { nullptr, real_constants<double>::pi(), false, 0 };
+					break;
+				case OPC_PUSH_E:
+					*top++ = { nullptr, real_constants<double>::e(), false, 0 };
+					break;
+				case OPC_PUSH_CONSTANT:
+					*top++ = { nullptr, get<V_REAL>(unbox<double>(constants[size_t(instruction.immediate)])), false, 0 };
+					break;
+				case OPC_PUSH_VARIABLE:
+					*top++ = { columns[size_t(instruction.immediate)] + first, 0, false, 0 };
+					break;
+				case OPC_CALL: {
+					top -= instruction.argCount;
+					if (none_of(top, top + instruction.argCount, [](column_slot const& s) { return s.data != nullptr; })) {
+						apply_numbers(instruction.operation, top++, instruction.argCount);	// checked by is_columnar()
+						break;
+					}
+					double* out = blocks.data() + size_t(top - stack.data()) * BATCH_BLOCK;
+					apply_columns(instruction.operation, top, out, n);
+					*top++ = { out, 0, false, 0 };
+					break;
 				}
-				else if (is<Result>(operationPTR))
-				{
-					// Variables to hold the lexical cast numbers
-					Real::value_type resultRealPower;
-					Real::value_type valueRealFirst;
-					Real::value_type valueRealSecond;
-
-					Integer::value_type resultIntegerPower;
-					Integer::value_type valueIntegerFirst;
-					Integer::value_type valueIntegerSecond;
-
-					if (isReal == false)
-					{
-						if (boolNumberFirst == true)
-						{
-							operandFirstNum *= 2;
-							operandStack.push_back(make<Integer>(operandFirstNum));
-							evaluated = true;
-							continue;
-						}
-						else if (boolNumberSecond == true)
-						{
-							operandSecNum *= 2;
-							operandStack.push_back(make<Integer>(operandSecNum));
-							evaluated = true;
-							continue;
-						}
-					}
-					else if (isReal == true)
-					{
-						if (boolRealNumberFirst == true)
-						{
-							RealOperandNumFirst *= 2.0;
-							operandStack.push_back(make<Real>(RealOperandNumFirst));
-							evaluated = true;
-							continue;
-						}
-						else if (boolRealNumberSecond == true)
-						{
-							RealOperandNumSec *= 2.0;
-							operandStack.push_back(make<Real>(RealOperandNumSec));
-							evaluated = true;
-							continue;
-						}
-					}
+				default:
+					assert(!"not a columnar program");
 				}
 			}
-		}	
-	}
-	// Throw exception if more than one operand is left after all of the evaluations
-	if (operandStack.size() > 1)
-	{
-		throw exception("Error: too many operands");
+			copy(stack.front().data, stack.front().data + n, results + first);
+		}
 	}
 
 
-	Operand::pointer_type finalResult = dynamic_pointer_cast<Operand>(operandStack.back());
 
-	return  finalResult; // final evaluated result
+	/*! Gets the precision tier whose value type is REAL. */
+	template <typename REAL> constexpr real_precision_type tier_of();
+	template <> constexpr real_precision_type tier_of<real_tier<PRECISION_DOUBLE>::value_type>() { return PRECISION_DOUBLE; }
+	template <> constexpr real_precision_type tier_of<real_tier<PRECISION_50>::value_type>() { return PRECISION_50; }
+	template <> constexpr real_precision_type tier_of<real_tier<PRECISION_100>::value_type>() { return PRECISION_100; }
+	template <> constexpr real_precision_type tier_of<real_tier<PRECISION_1000>::value_type>() { return PRECISION_1000; }
+}
+
+
+
+/** Evaluate a postfix token list.
+	The list is compiled to bytecode and run.
+	@return the single operand left on the stack.
+	*/
+Operand::pointer_type RPNEvaluator::evaluate(TokenList const& rpnExpression)
+{
+	// a lone operand is its own result
+	if (rpnExpression.size() == 1 && is<Operand>(rpnExpression.front()))
+		return static_pointer_cast<Operand>(rpnExpression.front());
+
+	return run(Compiler().compile(rpnExpression));
 }
 
+
+
+/** Run a compiled program.
+	Each operation is dispatched by its operation id through the kernel table of the current precision tier.
+	@return the program's result.
+	*/
+Operand::pointer_type RPNEvaluator::run(Program const& program)
+{
+	return dispatch(program, nullptr, nullptr);
+}
+
+
+
+/** Run a compiled program against an environment.
+	Variables with slots are read and assigned in the environment; the program is not changed,
+	so it can run against several environments at once.
+	*/
+Operand::pointer_type RPNEvaluator::run(Program const& program, Environment& environment) const
+{
+	return dispatch(program, nullptr, &environment);
+}
+
+
+
+/** Run a compiled program with its Variables bound to values.
+	Bound Variable tokens are not read or written, so threads can share the program.
+	*/
+Operand::pointer_type RPNEvaluator::run(Program const& program, vector<Operand::pointer_type> const& bindings)
+{
+	assert(bindings.size() == program.get_constants().size());
+	return dispatch(program, &bindings, nullptr);
+}
+
+
+
+Operand::pointer_type RPNEvaluator::dispatch(Program const& program, vector<Operand::pointer_type> const* bindings, Environment* environment) const
+{
+	assert((program.get_precision() == PRECISION_COUNT || program.get_precision() == precision_) && "folded at another precision");
+	switch (precision_) {
+	case PRECISION_DOUBLE:	return run_with<real_tier<PRECISION_DOUBLE>::value_type>(program, bindings, environment, history_.get());
+	case PRECISION_50:		return run_with<real_tier<PRECISION_50>::value_type>(program, bindings, environment, history_.get());
+	case PRECISION_100:		return run_with<real_tier<PRECISION_100>::value_type>(program, bindings, environment, history_.get());
+	default:				return run_with<real_tier<PRECISION_1000>::value_type>(program, bindings, environment, history_.get());
+	}
+}
+
+
+/** Run a compiled program once per row of a batch of columns.
+	In the double tier a program of arithmetic and real functions over the columns runs column-wise;
+	any other program runs once per row, reading the columns in place of the bound Variables.
+	*/
+template <typename VALUE_TYPE>
+void RPNEvaluator::run_batch(Program const& program, vector<VALUE_TYPE const*> const& columns, size_t rows, VALUE_TYPE* results, Environment* environment)
+{
+	assert((program.get_precision() == PRECISION_COUNT || program.get_precision() == precision_) && "folded at another precision");
+	assert(columns.size() == program.get_constants().size());
+	if (tier_of<VALUE_TYPE>() != precision_)
+		throw exception("Error: batch columns are not of the evaluator's precision");
+
+	if constexpr (is_same_v<VALUE_TYPE, double>)
+		if (is_columnar(program, columns)) {
+			run_columns(program, columns, rows, results);
+			return;
+		}
+	run_rows(program, columns, rows, results, environment, history_.get());
+}
+
+template void RPNEvaluator::run_batch(Program const&, vector<real_tier<PRECISION_DOUBLE>::value_type const*> const&, size_t, real_tier<PRECISION_DOUBLE>::value_type*, Environment*);
+template void RPNEvaluator::run_batch(Program const&, vector<real_tier<PRECISION_50>::value_type const*> const&, size_t, real_tier<PRECISION_50>::value_type*, Environment*);
+template void RPNEvaluator::run_batch(Program const&, vector<real_tier<PRECISION_100>::value_type const*> const&, size_t, real_tier<PRECISION_100>::value_type*, Environment*);
+template void RPNEvaluator::run_batch(Program const&, vector<real_tier<PRECISION_1000>::value_type const*> const&, size_t, real_tier<PRECISION_1000>::value_type*, Environment*);
+
+
 /*=============================================================
 
 Revision History
 
+Version 3.15.4: 2026-10-18
+An assignment drops the run's snapshot of the Environment so the Environment can update its values in place.
+
+Version 3.15.3: 2026-10-18
+Constant sub-expressions of a batch program are broadcast into the column path instead of forcing row-by-row evaluation.
+
+Version 3.15.2: 2026-10-18
+Whole bases raised to rational exponents are exact again; other Real powers use pow().
+
+Version 3.15.1: 2026-10-18
+Real powers go through pow() in the row kernels and the column path alike; (-1) ** even is 1.
+
+Version 3.15.0: 2026-10-18
+Result reads the evaluator's ResultHistory instead of doubling its argument.
+
+Version 3.14.0: 2026-10-18
+Power and Pow dispatch on the operand types without lexical_cast; Integer powers are sized before they are computed.
+
+Version 3.13.0: 2026-10-18
+Factorial uses the prime swing factorial engine.
+
+Version 3.12.0: 2026-10-18
+A run reads its Environment through one snapshot, renewed by its assignments.
+
+Version 3.11.0: 2026-10-18
+Added run() against an Environment.
+
+Version 3.10.0: 2026-10-18
+Added run() with bound values.
+
+Version 3.9.0: 2026-10-18
+Added run_batch(), with column-wise evaluation in the double tier.
+
+Version 3.8.0: 2026-10-18
+And, Or, Nand and Nor short-circuit.
+
+Version 3.7.0: 2026-10-18
+run() checks that a folded program is run at its precision.
+
+Version 3.6.0: 2026-10-18
+Boolean and small Integer results use the shared token caches.
+
+Version 3.5.0: 2026-10-18
+Expressions are compiled to bytecode and run by a VM loop; added run().
+
+Version 3.4.0: 2026-10-18
+Evaluation runs on a stack of unboxed values; only the result is boxed into a Token.
+
+Version 3.3.0: 2026-10-18
+Small Integers are computed with overflow checked long long arithmetic, falling back to cpp_int on overflow.
+
+Version 3.2.0: 2026-10-18
+Kernels are instantiated once per Real precision tier; the evaluator dispatches through the table of its tier.
+
+Version 3.1.0: 2026-10-18
+Replaced the Big If with an operation kernel table indexed by operation id.
+Ln is now the natural logarithm; Log (base 10) is evaluated.
+
 Version 3.0.0 2019-11-05
 By Sonia Friesen, Using the Big If
 
@@ -13,16 +13,74 @@
 
 #include "token.hpp"
 #include "operand.hpp"
+#include "real.hpp"
+#include <memory>
+#include <vector>
+
+class Environment;
+class Program;
+class ResultHistory;
 
 class RPNEvaluator {
+	real_precision_type						precision_;
+	std::shared_ptr<ResultHistory const>	history_;	// read by Result; none outside an ExpressionEvaluator
+
+	Operand::pointer_type dispatch( Program const& program, std::vector<Operand::pointer_type> const* bindings, Environment* environment ) const;
 public:
+	RPNEvaluator( real_precision_type precision = PRECISION_1000 ) : precision_( precision ) { }
+
+	/** Selects the precision tier used for Real arithmetic. */
+	void				set_precision( real_precision_type precision ) { precision_ = precision; }
+	real_precision_type	get_precision() const { return precision_; }
+
+	/** Sets the results read by the Result function. */
+	void				set_history( std::shared_ptr<ResultHistory const> history ) { history_ = std::move( history ); }
+
 	Operand::pointer_type evaluate( TokenList const& container );
+
+	/** Runs a compiled program. */
+	Operand::pointer_type run( Program const& program );
+
+	/** Runs a compiled program with the values of its Variables in an environment, by slot.
+		The program is only read, so it can run against several environments at once. */
+	Operand::pointer_type run( Program const& program, Environment& environment ) const;
+
+	/** Runs a compiled program without touching its Variables.
+		'bindings' has one entry per constant pool entry: the value pushed in place of the Variable there, or nullptr.
+		A program that only reads its Variables can be run this way by several threads at once. */
+	Operand::pointer_type run( Program const& program, std::vector<Operand::pointer_type> const& bindings );
+
+	/** Runs a compiled program once per row of a batch.
+		'columns' has one entry per constant pool entry: the column of values bound to that Variable, or nullptr.
+		Each row's numeric result is written to 'results', which holds 'rows' values.
+		Variables without a column have their values in 'environment', if given.
+		VALUE_TYPE is the value type of the current precision tier (real_tier<>::value_type). */
+	template <typename VALUE_TYPE>
+	void run_batch( Program const& program, std::vector<VALUE_TYPE const*> const& columns, size_t rows, VALUE_TYPE* results, Environment* environment = nullptr );
 };
 
 /*=============================================================
 
 Revision History
 
+Version 0.6.0: 2026-10-18
+Added set_history() for the Result function.
+
+Version 0.5.0: 2026-10-18
+Added run() against an Environment.
+
+Version 0.4.0: 2026-10-18
+Added run() with bound values.
+
+Version 0.3.0: 2026-10-18
+Added run_batch().
+
+Version 0.2.0: 2026-10-18
+Added run().
+
+Version 0.1.0: 2026-10-18
+Added selectable Real precision tier.
+
 Version 0.0.1: 2012-11-13
 C++ 11 cleanup
 
@@ -0,0 +1,220 @@
+/*! \file		batch_evaluator.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		BatchEvaluator class implementation.
+	*/
+
+#include "../inc/batch_evaluator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+using namespace std;
+
+namespace {
+	/*! An expression compiled for a batch, with the constant pool indices of each of its variables. */
+	struct batch_program {
+		Program									program;
+		map<Token::string_type, vector<size_t>>	slots;
+	};
+
+	/*! A half-open range of job indices. */
+	struct job_range {
+		size_t	first;
+		size_t	last;
+	};
+
+	/*! A worker's ranges of jobs.  The owner takes from the back, where the smallest ranges are;
+		thieves take from the front, where the largest are. */
+	class range_deque {
+		mutex				mutex_;
+		deque<job_range>	ranges_;
+	public:
+		void push(job_range range) {
+			lock_guard<mutex> lock(mutex_);
+			ranges_.push_back(range);
+		}
+		bool pop(job_range& range) {
+			lock_guard<mutex> lock(mutex_);
+			if (ranges_.empty())
+				return false;
+			range = ranges_.back();
+			ranges_.pop_back();
+			return true;
+		}
+		bool steal(job_range& range) {
+			lock_guard<mutex> lock(mutex_);
+			if (ranges_.empty())
+				return false;
+			range = ranges_.front();
+			ranges_.pop_front();
+			return true;
+		}
+	};
+
+	bool assigns(Program const& program) {
+		Program::code_type const& code = program.get_code();
+		return any_of(code.begin(), code.end(), [](Instruction const& i) { return i.opcode == OPC_CALL && i.operation == OP_ASSIGNMENT; });
+	}
+}
+
+
+
+BatchEvaluator::BatchEvaluator(unsigned threads) {
+	set_threads(threads);
+}
+
+
+
+void BatchEvaluator::set_threads(unsigned threads) {
+	threads_ = threads ? threads : max(1u, thread::hardware_concurrency());
+}
+
+
+
+vector<BatchEvaluator::result_type> BatchEvaluator::evaluate(vector<Job> const& jobs) {
+	// compile each distinct expression once
+	vector<batch_program> programs;
+	vector<batch_program const*> jobPrograms(jobs.size());
+	{
+		unordered_map<expression_type, size_t> index;
+		vector<size_t> jobIndex(jobs.size());
+		for (size_t i = 0; i < jobs.size(); ++i) {
+			auto found = index.find(jobs[i].expression);
+			if (found == index.end()) {
+				PreparedExpression prepared = compiler_.compile(jobs[i].expression);
+				if (assigns(prepared.get_program()))
+					throw exception("Error: batch expressions cannot assign variables");
+
+				batch_program compiled{ prepared.get_program(), {} };
+				Program::constant_pool_type const& constants = compiled.program.get_constants();
+				for (auto const& variable : prepared.get_variables())
+					for (size_t slot = 0; slot < constants.size(); ++slot)
+						if (constants[slot].get() == variable.second.get())
+							compiled.slots[variable.first].push_back(slot);
+
+				found = index.emplace(jobs[i].expression, programs.size()).first;
+				programs.push_back(move(compiled));
+			}
+			jobIndex[i] = found->second;
+		}
+		for (size_t i = 0; i < jobs.size(); ++i)
+			jobPrograms[i] = &programs[jobIndex[i]];
+	}
+
+	vector<result_type> results(jobs.size());
+	vector<exception_ptr> errors(jobs.size());
+
+	size_t const nWorkers = max<size_t>(1, min<size_t>(threads_, jobs.size()));
+	vector<range_deque> queues(nWorkers);
+	if (!jobs.empty())
+		for (size_t w = 0; w < nWorkers; ++w)
+			queues[w].push({ jobs.size() * w / nWorkers, jobs.size() * (w + 1) / nWorkers });
+
+	// Idle workers sleep until a range is published or the last job finishes.
+	atomic<size_t> remaining(jobs.size());
+	mutex idleMutex;
+	condition_variable idle;
+	size_t published = 0;	// guarded by idleMutex
+	auto wake = [&](bool publish) {
+		{
+			lock_guard<mutex> lock(idleMutex);
+			published += publish;
+		}
+		idle.notify_all();
+	};
+
+	RPNEvaluator const rpn(compiler_.get_precision());
+	auto work = [&](size_t self) {
+		RPNEvaluator evaluator(rpn);
+		vector<Operand::pointer_type> bindings;
+		job_range range;
+		while (remaining.load() != 0) {
+			size_t seen;
+			{
+				lock_guard<mutex> lock(idleMutex);
+				seen = published;
+			}
+			bool found = queues[self].pop(range);
+			for (size_t victim = (self + 1) % nWorkers; !found && victim != self; victim = (victim + 1) % nWorkers)
+				found = queues[victim].steal(range);
+			if (!found) {	// a busy worker may be about to push the halves of its range
+				unique_lock<mutex> lock(idleMutex);
+				idle.wait(lock, [&] { return remaining.load() == 0 || published != seen; });
+				continue;
+			}
+
+			// keep the first job and leave the rest, in halves, for this worker or a thief
+			if (range.last - range.first > 1) {
+				while (range.last - range.first > 1) {
+					size_t middle = range.first + (range.last - range.first) / 2;
+					queues[self].push({ middle, range.last });
+					range.last = middle;
+				}
+				wake(true);
+			}
+
+			size_t const i = range.first;
+			try {
+				batch_program const& compiled = *jobPrograms[i];
+				bindings.assign(compiled.program.get_constants().size(), nullptr);
+				for (auto const& binding : jobs[i].bindings) {
+					auto slots = compiled.slots.find(binding.first);
+					if (slots == compiled.slots.end())
+						throw exception(("Error: unknown variable <" + binding.first + ">").c_str());
+					for (size_t slot : slots->second)
+						bindings[slot] = binding.second;
+				}
+				for (auto const& slots : compiled.slots)
+					if (!bindings[slots.second.front()])
+						throw exception("Error: variable not initialized");
+				results[i] = evaluator.run(compiled.program, bindings);
+			}
+			catch (...) {
+				errors[i] = current_exception();
+			}
+			if (--remaining == 0)
+				wake(false);
+		}
+	};
+
+	// the calling thread is worker 0
+	vector<thread> workers;
+	for (size_t w = 1; w < nWorkers; ++w)
+		workers.emplace_back(work, w);
+	work(0);
+	for (thread& worker : workers)
+		worker.join();
+
+	for (exception_ptr const& error : errors)
+		if (error)
+			rethrow_exception(error);
+	return results;
+}
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
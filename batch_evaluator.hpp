@@ -0,0 +1,74 @@
+#pragma once
+
+/*! \file		batch_evaluator.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		BatchEvaluator class declaration.
+	*/
+
+#include "expression_evaluator.hpp"
+#include <map>
+#include <vector>
+
+
+/*! Evaluates many (expression, bindings) jobs on several threads.
+	Each distinct expression is compiled once, on the calling thread, into a program the workers share read-only;
+	each worker runs it with its own bindings and operand stack.  Jobs are spread by work stealing: a worker splits
+	its range of jobs in halves that idle workers can take, so one slow job holds up only itself.
+	*/
+class BatchEvaluator {
+public:
+	typedef Token::string_type							expression_type;
+	typedef Token::string_type							name_type;
+	typedef Token::pointer_type							result_type;
+	typedef std::map<name_type, Operand::pointer_type>	binding_map_type;
+
+	/*! An expression and the values of its variables. */
+	struct Job {
+		expression_type		expression;
+		binding_map_type	bindings;
+	};
+private:
+	ExpressionEvaluator	compiler_;
+	unsigned			threads_;
+public:
+	/*! Creates an evaluator with 'threads' workers; 0 uses one per hardware thread. */
+	explicit BatchEvaluator( unsigned threads = 0 );
+
+	/*! Evaluates the jobs, giving their results in the same order.
+		Expressions may read their variables but not assign them; every variable used must be bound by the job.
+		@note Throws the error of the first failing job, in input order, once every job has run.
+		An expression that does not compile throws before any job runs.
+		*/
+	std::vector<result_type>	evaluate( std::vector<Job> const& jobs );
+
+	void				set_threads( unsigned threads );
+	unsigned			get_threads() const { return threads_; }
+
+	/*! Selects the precision tier used for Real arithmetic. */
+	void				set_precision( real_precision_type precision ) { compiler_.set_precision( precision ); }
+	real_precision_type	get_precision() const { return compiler_.get_precision(); }
+};
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -18,10 +18,36 @@ Boolean::string_type Boolean::to_string() const {
 }
 
 
+/*! True and False equal any Boolean of the same value. */
+bool Boolean::equals(Token const& other) const {
+	auto rhs = dynamic_cast<Boolean const*>(&other);
+	return rhs && value_ == rhs->value_;
+}
+
+
+std::size_t Boolean::hash() const {
+	return std::hash<value_type>()(value_);
+}
+
+
+Operand::pointer_type make_boolean(Boolean::value_type value) {
+	static Operand::pointer_type const trueToken = std::static_pointer_cast<Operand>(flyweight<True>());
+	static Operand::pointer_type const falseToken = std::static_pointer_cast<Operand>(flyweight<False>());
+	return value ? trueToken : falseToken;
+}
+
+
+
 /*=============================================================
 
 Revision History
 
+Version 1.2.0: 2026-10-18
+Added equals() and hash().
+
+Version 1.1.0: 2026-10-18
+Added make_boolean().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
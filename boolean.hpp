@@ -18,33 +18,53 @@ class Boolean : public Operand {
 public:
 	using value_type = bool;
 	DEF_POINTER_TYPE(Boolean)
+	static constexpr token_kind_type KIND = Operand::KIND | TK_BOOLEAN;
 private:
 	value_type	value_;
+protected:
+	Boolean(value_type const& value, token_kind_type kind) : Operand(kind | TK_BOOLEAN), value_(value) { }
 public:
-	Boolean(value_type const& value) : value_(value) { }
+	Boolean(value_type const& value) : Operand(TK_BOOLEAN), value_(value) { }
 
 	value_type				get_value() const { return value_; }
 	string_type				to_string() const;
+	bool					equals(Token const& other) const override;
+	std::size_t				hash() const override;
 };
 
 
 /*! Boolean True literal. */
 class True : public Boolean {
 public:
-	True() : Boolean(true) { }
+	static constexpr token_kind_type KIND = Boolean::KIND | TK_TRUE;
+	True() : Boolean(true, TK_TRUE) { }
 };
 
 /*! Boolean False literal. */
 class False : public Boolean {
 public:
-	False() : Boolean(false) { }
+	static constexpr token_kind_type KIND = Boolean::KIND | TK_FALSE;
+	False() : Boolean(false, TK_FALSE) { }
 };
 
 
+/*! Gets the shared True or False token for a value. */
+Operand::pointer_type make_boolean(Boolean::value_type value);
+
+
 /*=============================================================
 
 Revision History
 
+Version 1.3.0: 2026-10-18
+Added token kinds.
+
+Version 1.2.0: 2026-10-18
+Added value equality and hashing.
+
+Version 1.1.0: 2026-10-18
+Added make_boolean().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -0,0 +1,265 @@
+/*! \file		compiler.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Compiler class implementation.
+	*/
+
+#include "../inc/compiler.hpp"
+#include "../inc/boolean.hpp"
+#include "../inc/integer.hpp"
+#include "../inc/real.hpp"
+#include "../inc/RPNEvaluator.hpp"
+#include "../inc/variable.hpp"
+#include <algorithm>
+#include <exception>
+using namespace std;
+
+namespace {
+	bool is_short_circuit(operation_id_type id) {
+		return id == OP_AND || id == OP_OR || id == OP_NAND || id == OP_NOR;
+	}
+}
+
+
+
+Program Compiler::compile(TokenList const& postfixTokens) {
+	if (postfixTokens.empty())
+		throw exception("Error: insufficient operands");
+
+	Program program;
+	program.code_.reserve(postfixTokens.size());
+	size_t depth = 0;
+
+	// where the code of each value on the stack starts, and the short-circuit jumps to insert at such starts
+	vector<size_t> starts;
+	vector<pair<size_t, Instruction>> jumps;
+
+	auto emit = [&](opcode_type opcode, Integer::small_type immediate) {
+		starts.push_back(program.code_.size());
+		program.code_.push_back(Instruction{ opcode, 0, OP_COUNT, immediate });
+		program.maxDepth_ = max(program.maxDepth_, ++depth);
+	};
+	auto pool = [&](Token::pointer_type const& token) {
+		program.constants_.push_back(token);
+		return Integer::small_type(program.constants_.size() - 1);
+	};
+
+	for (auto const& token : postfixTokens)
+	{
+		if (is<Operand>(token)) {
+			if (is<Integer>(token)) {
+				Integer const* i = static_cast<Integer const*>(token.get());
+				if (i->is_small())
+					emit(OPC_PUSH_SMALL, i->get_small());
+				else
+					emit(OPC_PUSH_CONSTANT, pool(token));
+			}
+			else if (is<Boolean>(token))
+				emit(OPC_PUSH_BOOLEAN, get_value<Boolean>(token) ? 1 : 0);
+			else if (is<Pi>(token))
+				emit(OPC_PUSH_PI, 0);
+			else if (is<E>(token))
+				emit(OPC_PUSH_E, 0);
+			else if (is<Real>(token))
+				emit(OPC_PUSH_CONSTANT, pool(token));
+			else if (is<Variable>(token))
+				emit(OPC_PUSH_VARIABLE, pool(token));
+			else
+				throw exception("Error: unknown token");
+			continue;
+		}
+
+		auto operation = convert<Operation>(token);
+		if (!operation)
+			throw exception("Error: unknown token");
+
+		unsigned nArgs = operation->number_of_args();
+		if (nArgs > depth)
+			throw exception("Insufficient number of operands for operation");
+
+		operation_id_type id = operation->get_operation_id();
+		if (id == OP_COUNT)
+			throw exception("Error: unknown token");
+
+		// the jump goes between the left and the right operand
+		if (nArgs == 2 && is_short_circuit(id))
+			jumps.emplace_back(starts[depth - 1], Instruction{ OPC_SHORT_CIRCUIT, 0, static_cast<unsigned short>(id), Integer::small_type(program.code_.size()) });
+
+		program.code_.push_back(Instruction{ OPC_CALL, static_cast<unsigned char>(nArgs), static_cast<unsigned short>(id), 0 });
+		depth = depth - nArgs + 1;
+		starts.resize(depth);
+		program.maxDepth_ = max(program.maxDepth_, depth);
+	}
+
+	if (depth > 1)
+		throw exception("Error: too many operands");
+
+	if (jumps.empty())
+		return program;
+
+	// merge the jumps into the code in one pass; each instruction moves down by the jumps inserted at or before it
+	stable_sort(jumps.begin(), jumps.end(), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+	vector<size_t> positions;
+	positions.reserve(jumps.size());
+	for (auto const& jump : jumps)
+		positions.push_back(jump.first);
+
+	Program::code_type code;
+	code.reserve(program.code_.size() + jumps.size());
+	auto jump = jumps.begin();
+	for (size_t i = 0; i < program.code_.size(); ++i) {
+		for (; jump != jumps.end() && jump->first == i; ++jump)
+			code.push_back(jump->second);
+		code.push_back(program.code_[i]);
+	}
+	for (Instruction& instruction : code)
+		if (instruction.opcode == OPC_SHORT_CIRCUIT)
+			instruction.immediate += upper_bound(positions.begin(), positions.end(), size_t(instruction.immediate)) - positions.begin();
+	program.code_ = move(code);
+
+	return program;
+}
+
+
+
+Program Compiler::fold_constants(Program const& program, RPNEvaluator rpn) {
+	Program folded;
+	folded.precision_ = rpn.get_precision();
+	folded.code_.reserve(program.code_.size());
+	folded.constants_ = program.constants_;
+
+	// one flag per value on the stack; a constant value is always a single push instruction
+	vector<bool> constant;
+	constant.reserve(program.maxDepth_);
+
+	// where each instruction of the program went, for the jump targets
+	vector<size_t> moved(program.code_.size());
+
+	auto run = [&](Program::code_type code, Program::constant_pool_type constants, size_t depth) -> Operand::pointer_type {
+		Program sub;
+		sub.code_ = move(code);
+		sub.constants_ = move(constants);
+		sub.maxDepth_ = depth;
+		try {
+			return rpn.run(sub);
+		}
+		catch (exception&) {
+			return nullptr;
+		}
+	};
+
+	// the instruction that pushes a folded result, if running it gives back that same result
+	auto push_result = [&](Operand::pointer_type const& result, Instruction& push) {
+		if (is<Integer>(result) && static_cast<Integer const*>(result.get())->is_small()) {
+			push = Instruction{ OPC_PUSH_SMALL, 0, OP_COUNT, static_cast<Integer const*>(result.get())->get_small() };
+			return true;
+		}
+		if (is<Boolean>(result)) {
+			push = Instruction{ OPC_PUSH_BOOLEAN, 0, OP_COUNT, get_value<Boolean>(result) ? 1 : 0 };
+			return true;
+		}
+		if (is<Real>(result)) {
+			// a Real is stored at full precision; the tier must read it back unchanged (e.g. subnormal doubles do not)
+			auto reread = run({ Instruction{ OPC_PUSH_CONSTANT, 0, OP_COUNT, 0 } }, { result }, 1);
+			if (!reread || !reread->equals(*result))
+				return false;
+		}
+		push = Instruction{ OPC_PUSH_CONSTANT, 0, OP_COUNT, Integer::small_type(folded.constants_.size()) };
+		folded.constants_.push_back(result);
+		return true;
+	};
+
+	for (size_t i = 0; i < program.code_.size(); ++i) {
+		Instruction const& instruction = program.code_[i];
+		if (instruction.opcode == OPC_SHORT_CIRCUIT) {
+			// the logical operation depends on run time control flow; it and everything around it is not folded
+			folded.code_.push_back(instruction);
+			constant.back() = false;
+			continue;
+		}
+		if (instruction.opcode != OPC_CALL) {
+			folded.code_.push_back(instruction);
+			constant.push_back(instruction.opcode != OPC_PUSH_VARIABLE);
+			continue;
+		}
+
+		size_t nArgs = instruction.argCount;
+		bool foldable = instruction.operation != OP_ASSIGNMENT && instruction.operation != OP_RESULT
+			&& all_of(constant.end() - nArgs, constant.end(), [](bool c) { return c; });
+		constant.resize(constant.size() - nArgs);
+
+		Instruction push;
+		if (foldable) {
+			// the operands are the last nArgs instructions
+			Program::code_type code(folded.code_.end() - nArgs, folded.code_.end());
+			Program::constant_pool_type constants;
+			for (Instruction& operand : code)
+				if (operand.opcode == OPC_PUSH_CONSTANT) {
+					constants.push_back(folded.constants_[size_t(operand.immediate)]);
+					operand.immediate = Integer::small_type(constants.size() - 1);
+				}
+			code.push_back(instruction);
+
+			auto result = run(move(code), move(constants), nArgs);
+			foldable = result && push_result(result, push);
+		}
+
+		if (foldable) {
+			folded.code_.resize(folded.code_.size() - nArgs);
+			folded.code_.push_back(push);
+		}
+		else
+			folded.code_.push_back(instruction);
+		constant.push_back(foldable);
+		moved[i] = folded.code_.size() - 1;
+	}
+
+	// drop the constants of folded operands and recompute the stack depth
+	Program::constant_pool_type used;
+	size_t depth = 0;
+	for (Instruction& instruction : folded.code_) {
+		if (instruction.opcode == OPC_PUSH_CONSTANT || instruction.opcode == OPC_PUSH_VARIABLE) {
+			used.push_back(folded.constants_[size_t(instruction.immediate)]);
+			instruction.immediate = Integer::small_type(used.size() - 1);
+		}
+		if (instruction.opcode == OPC_SHORT_CIRCUIT)
+			instruction.immediate = Integer::small_type(moved[size_t(instruction.immediate)]);
+		else
+			depth = instruction.opcode == OPC_CALL ? depth - instruction.argCount + 1 : depth + 1;
+		folded.maxDepth_ = max(folded.maxDepth_, depth);
+	}
+	folded.constants_ = move(used);
+
+	return folded;
+}
+
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.2.0: 2026-10-18
+And, Or, Nand and Nor compile to short-circuit jumps.
+
+Version 1.1.0: 2026-10-18
+Added fold_constants().
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
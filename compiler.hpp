@@ -0,0 +1,111 @@
+#pragma once
+
+/*! \file		compiler.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Bytecode Program and Compiler class declarations.
+	*/
+
+#include "token.hpp"
+#include "operand.hpp"
+#include "operation.hpp"
+#include "integer.hpp"
+#include "real.hpp"
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+class RPNEvaluator;
+
+
+/*! Bytecode opcodes. */
+enum opcode_type : unsigned char {
+	OPC_PUSH_SMALL,		// push the immediate as an Integer
+	OPC_PUSH_BOOLEAN,	// push the immediate as a Boolean
+	OPC_PUSH_PI,		// push Pi at the evaluator's precision
+	OPC_PUSH_E,			// push E at the evaluator's precision
+	OPC_PUSH_CONSTANT,	// push constant pool entry 'immediate'
+	OPC_PUSH_VARIABLE,	// push a reference to the Variable at constant pool entry 'immediate'
+	OPC_CALL,			// apply kernel 'operation' to the top 'argCount' values
+	OPC_SHORT_CIRCUIT	// if the top value decides logical 'operation', make it the result and jump past the call at 'immediate'
+};
+
+
+/*! A bytecode instruction. */
+struct Instruction {
+	opcode_type			opcode;
+	unsigned char		argCount;
+	unsigned short		operation;		// operation_id_type of OPC_CALL
+	Integer::small_type	immediate;		// literal value, constant pool index or jump target
+};
+
+
+/*! A compiled postfix expression: a flat instruction array and the operands too large to inline. */
+class Program {
+public:
+	using code_type = std::vector<Instruction>;
+	using constant_pool_type = std::vector<Token::pointer_type>;
+private:
+	code_type			code_;
+	constant_pool_type	constants_;
+	size_t				maxDepth_ = 0;
+	real_precision_type	precision_ = PRECISION_COUNT;
+public:
+	code_type const&			get_code() const { return code_; }
+	constant_pool_type const&	get_constants() const { return constants_; }
+
+	/*! Gets the deepest the value stack gets while running the program. */
+	size_t						get_max_depth() const { return maxDepth_; }
+
+	/*! Gets the precision the program's constants were folded at, or PRECISION_COUNT if it is not folded.
+		A folded program must be run at that precision. */
+	real_precision_type			get_precision() const { return precision_; }
+
+	friend class Compiler;
+};
+
+
+/*! Compiles postfix token lists into Programs. */
+class Compiler : boost::noncopyable {
+public:
+	/*! Lowers a postfix token list to bytecode.
+		And, Or, Nand and Nor short-circuit: a Boolean left operand that decides the result skips the right operand,
+		including any assignment in it, exactly as if the right operand were not in the expression.
+		Throws on a structurally invalid expression (empty, too few or too many operands, unknown tokens). */
+	Program compile( TokenList const& postfixTokens );
+
+	/*! Constant folding: replaces every call whose operands are all constant by its result, computed by 'rpn'.
+		Assignment and Result are never folded, nor is a call that throws; its error is left for run time.
+		Run at rpn's precision, the folded program gives exactly the results of the original. */
+	Program fold_constants( Program const& program, RPNEvaluator rpn );
+};
+
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.2.0: 2026-10-18
+Added OPC_SHORT_CIRCUIT for And, Or, Nand and Nor.
+
+Version 1.1.0: 2026-10-18
+Added constant folding.
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -8,19 +8,22 @@
 	*/
 
 #include "../ee_common/inc/expression_evaluator.hpp"
+#include "../ee_common/inc/boolean.hpp"
 #include "../ee_common/inc/function.hpp"
+#include "../ee_common/inc/integer.hpp"
 #include "../ee_common/inc/real.hpp"
 #include "../ee_common/inc/variable.hpp"
 #include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <regex>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 
-//NOTE: Using Big IF, The email I sent with the operator polymorph issue was not resolved in time for the due date. For me to get this done in a timely fashion and handed in with the boost tests working, I had to quickly do the Big If (well not exatly quickly more like a few hours with lots of code). 
 int main()
 {
 	cout << "Expression Evaluator, (c) 1998-2019 Garth Santor\n";
@@ -28,8 +31,11 @@ int main()
 	cout << "Enter 'help' for a reference \n";
 
 	ExpressionEvaluator ee;
+	ee.set_cache_capacity(256);
+	unsigned outputDigits = 0;	// set by setp; 0 = shortest round trip, or 6 places for fixed and sci
+	real_format_type outputFormat = FORMAT_GENERAL;	// 'shortest': the fewest digits that read back in the tier
 
-	for (unsigned count = 0; ; ++count) {
+	for (;;) {
 
 		try
 		{
@@ -48,7 +54,8 @@ int main()
 				cout << "Expression Evaluator 2019 (v 3.0.0)\n\n"
 
 					"var = assign a variable\n"
-					"setp #          sets the precision of floating point output\n\n"
+					"setp #          sets the precision of floating point output\n"
+					"setf fixed|sci|shortest    sets the notation of floating point output\n\n"
 
 					"arithmetic operations :\n"
 					"addition                n + r\n"
@@ -93,54 +100,81 @@ int main()
 					"maximum                         max(a, b)\n"
 					"minimum                         min(a, b)\n"
 					"power                           pow(base, exponent)\n"
+					"result n (-1 is the last)       result(n)\n"
 					"sine                            sin(r)\n"
 					"square root                     sqrt(r)\n"
 					"tangent                         tan(r)" << endl;
 				continue;
 			}
 
-			// Convert the evaluated expression to a Token pointer
-			auto result = ee.evaluate(command);
+			// Set the real number precision; the cheapest engine tier that holds the digits is selected
+			if (command.compare(0, 5, "setp ") == 0)
+			{
+				istringstream iss(command.substr(5));
+				unsigned digits;
+				if (!(iss >> digits) || digits == 0)
+				{
+					cerr << "Error: setp requires a positive number of digits" << endl;
+					continue;
+				}
+				ee.set_precision(precision_for_digits(digits));
+				outputDigits = digits;
+				cout << "precision: " << digits << " (" << digits_of(ee.get_precision()) << " digit engine)" << endl;
+				continue;
+			}
 
-			Operand::pointer_type varPtr = dynamic_pointer_cast<Operand>(result);
+			// Set the real number notation
+			if (command.compare(0, 5, "setf ") == 0)
+			{
+				string mode = command.substr(5);
+				if (mode == "fixed")
+					outputFormat = FORMAT_FIXED;
+				else if (mode == "sci")
+					outputFormat = FORMAT_SCIENTIFIC;
+				else if (mode == "shortest")
+					outputFormat = FORMAT_GENERAL;
+				else
+				{
+					cerr << "Error: setf requires fixed, sci or shortest" << endl;
+					continue;
+				}
+				cout << "notation: " << mode << endl;
+				continue;
+			}
 
-			// Cast the value to a string to be displayed
-			string str = result->to_string();
-			string strCheck = "";
-			strCheck = str[0];
+			// Convert the evaluated expression to a Token pointer
+			auto result = ee.evaluate(command);
+			if (is<Variable>(result) && get_value<Variable>(result))
+				result = get_value<Variable>(result);
 
-			// Check whether it is an Integer, Real, Boolean, or Variable. Then
-			// remove the characters of Integer, Real, Boolean, or Variable to display
-			// just the value.
-			if (strCheck == "I")
+			// Reals are written straight from their digits, with the digits and notation chosen by setp and setf
+			string str;
+			if (is<Real>(result))
 			{
-				str = str.substr(9);
+				Real::value_type const value = get_value<Real>(result);
+				unsigned digits = outputDigits != 0 ? outputDigits : 6;
+				if (outputFormat == FORMAT_GENERAL)	// the fewest digits that read back, but no more than setp asked for
+				{
+					unsigned const shortest = round_trip_digits(value, ee.get_precision());
+					digits = outputDigits != 0 ? min(outputDigits, shortest) : shortest;
+				}
+				str = format_real(value, outputFormat, digits);
 			}
-			else if (strCheck == "R")
+			else if (is<Integer>(result))
 			{
-				str = str.substr(5);
+				str = to_decimal(get_value<Integer>(result), thread::hardware_concurrency());
 			}
-			else if (strCheck == "V")
+			else if (is<Boolean>(result))
 			{
-				Token::pointer_type variableValue = get_value<Variable>(varPtr);
-				str = variableValue->to_string();
-				str = str.substr(9);
+				str = get_value<Boolean>(result) ? "true" : "false";
 			}
-			else if (strCheck == "B")
+			else
 			{
-				str = str.substr(9);
-
-				if (str == "1")
-				{
-					str = "true";
-				}
-				else
-				{
-					str = "false";
-				}
+				str = result->to_string();
 			}
 
-			cout << "[" << count << "] = " << str << endl;
+			// the number is the one result(n) reads
+			cout << "[" << ee.get_history().last() << "] = " << str << endl;
 		}
 		catch (exception e)
 		{
@@ -159,6 +193,25 @@ int main()
 
 Revision History
 
+Version 3.5.1: 2026-10-18
+setf shortest writes the fewest digits that read back as the same value in the precision tier, at most the digits of setp.
+
+Version 3.5.0: 2026-10-18
+Results are numbered by the evaluator's history, from 1, so [n] is result(n).
+
+Version 3.4.0: 2026-10-18
+Integers are printed with to_decimal() on every hardware thread.
+
+Version 3.3.0: 2026-10-18
+Reals are printed with format_real(); added setf to choose the notation.
+Results are shown by token kind instead of by the first character of to_string().
+
+Version 3.2.0: 2026-10-18
+Enabled the program cache.
+
+Version 3.1.0: 2026-10-18
+setp selects the Real precision tier of the evaluator as well as the output digits.
+
 Version 3.0.0 2019-11-05
 By Sonia Friesen, Using the Big If
 
@@ -0,0 +1,76 @@
+/*! \file		environment.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.1.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Environment class implementation.
+	*/
+
+#include "../inc/environment.hpp"
+using namespace std;
+
+Environment::Environment() : values_(make_shared<slot_array_type const>()) { }
+
+
+
+Environment::Environment(Environment const& other) : values_(other.snapshot()) { }
+
+
+
+Environment& Environment::operator = (Environment const& other) {
+	snapshot_type values = other.snapshot();
+	lock_guard<mutex> lock(guard_);
+	values_ = move(values);
+	return *this;
+}
+
+
+
+Environment::snapshot_type Environment::snapshot() const {
+	lock_guard<mutex> lock(guard_);
+	return values_;
+}
+
+
+
+Environment::value_type Environment::get(slot_type slot) const {
+	snapshot_type values = snapshot();
+	return slot < values->size() ? (*values)[slot] : value_type();
+}
+
+
+
+void Environment::set(slot_type slot, value_type value) {
+	lock_guard<mutex> lock(guard_);
+	if (values_.use_count() > 1)
+		values_ = make_shared<slot_array_type>(*values_);
+	// every array is made non-const; only the snapshots are const
+	slot_array_type& values = const_cast<slot_array_type&>(*values_);
+	if (slot >= values.size())
+		values.resize(slot + 1);
+	values[slot] = move(value);
+}
+
+/*=============================================================
+
+Revision History
+
+Version 1.1.0: 2026-10-18
+Assignments update an unshared array in place instead of copying it.
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
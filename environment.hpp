@@ -0,0 +1,68 @@
+#pragma once
+
+/*! \file		environment.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.1.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Environment class declaration.
+	*/
+
+#include "operand.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/*! The values of the variables of an evaluation, indexed by the Variables' slots.
+	The values are an array that an assignment copies only while a snapshot or another Environment shares it
+	(copy-on-write), so a reader holding a snapshot never sees a change, and an assignment that nothing shares
+	updates its slot in place.  Copying an Environment shares the array until either copy is assigned.
+	*/
+class Environment {
+public:
+	typedef std::size_t								slot_type;
+	typedef Operand::pointer_type					value_type;
+	typedef std::vector<value_type>					slot_array_type;
+	typedef std::shared_ptr<slot_array_type const>	snapshot_type;
+private:
+	snapshot_type		values_;
+	mutable std::mutex	guard_;		// guards values_, so no snapshot can be taken while set() finds it unshared
+public:
+	Environment();
+	Environment( Environment const& other );
+	Environment& operator = ( Environment const& other );
+
+	/*! Gets the current values.  Later assignments do not change a snapshot. */
+	snapshot_type	snapshot() const;
+
+	/*! Gets the value in a slot; null if it was never assigned. */
+	value_type		get( slot_type slot ) const;
+
+	/*! Assigns a slot, in place unless the array of values is shared. */
+	void			set( slot_type slot, value_type value );
+};
+
+/*=============================================================
+
+Revision History
+
+Version 1.1.0: 2026-10-18
+Assignments update an unshared array in place instead of copying it.
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -13,23 +13,178 @@
 #include "../inc/parser.hpp"
 #include "../inc/RPNEvaluator.hpp"
 #include "../inc/function.hpp"
+#include "../inc/variable.hpp"
+#include <algorithm>
+#include <cassert>
+using namespace std;
 
 #if defined(SHOW_STEPS)
 #include <iostream>
 #endif
 
 ExpressionEvaluator::result_type	ExpressionEvaluator::evaluate(expression_type const& expr) {
+	if (cache_.get_capacity() == 0) {
+		TokenList infixTokens = tokenizer_.tokenize(expr);
+		TokenList postfixTokens = parser_.parse(infixTokens);
+		Operand::pointer_type result = rpn_.run(compiler_.compile(postfixTokens), *environment_);
+		history_->record(result);
+		return result;
+	}
+
+	ProgramCache::key_type key = tokenizer_.normalize(expr);
+	Program const* program = cache_.find(key);
+	if (!program) {
+		TokenList infixTokens = tokenizer_.tokenize(expr);
+		TokenList postfixTokens = parser_.parse(infixTokens);
+		program = &cache_.insert(key, compiler_.fold_constants(compiler_.compile(postfixTokens), rpn_));
+	}
+	Operand::pointer_type result = rpn_.run(*program, *environment_);
+	history_->record(result);
+	return result;
+}
+
+
+
+void ExpressionEvaluator::set_precision(real_precision_type precision) {
+	if (precision != rpn_.get_precision())
+		cache_.clear();
+	rpn_.set_precision(precision);
+}
+
+
+
+PreparedExpression ExpressionEvaluator::compile(expression_type const& expr) {
 	TokenList infixTokens = tokenizer_.tokenize(expr);
 	TokenList postfixTokens = parser_.parse(infixTokens);
-	Operand::pointer_type result = rpn_.evaluate(postfixTokens);
-	return result;
+	Program program = compiler_.fold_constants(compiler_.compile(postfixTokens), rpn_);
+
+	// the variables are those of the program's constant pool, named by their slots
+	PreparedExpression::variable_map_type variables;
+	for (auto const& constant : program.get_constants())
+		if (is<Variable>(constant)) {
+			Variable::pointer_type variable = convert<Variable>(constant);
+			variables[tokenizer_.get_symbols().name(variable->get_slot())] = variable;
+		}
+
+	return PreparedExpression(move(program), move(variables), rpn_, environment_);
 }
 
 
+
+void PreparedExpression::bind(name_type const& name, Operand::pointer_type const& value) {
+	auto iter = variables_.find(name);
+	if (iter == variables_.end())
+		throw exception(("Error: unknown variable <" + name + ">").c_str());
+	environment_->set(iter->second->get_slot(), value);
+}
+
+
+template <typename VALUE_TYPE>
+PreparedExpression::column_type<VALUE_TYPE> PreparedExpression::evaluate_batch(column_map_type<VALUE_TYPE> const& columns) {
+	size_t rows = columns.empty() ? 0 : columns.begin()->second->size();
+
+	// the column of each Variable in the constant pool
+	Program::constant_pool_type const& constants = program_.get_constants();
+	vector<VALUE_TYPE const*> poolColumns(constants.size(), nullptr);
+	for (auto const& column : columns) {
+		auto iter = variables_.find(column.first);
+		if (iter == variables_.end())
+			throw exception(("Error: unknown variable <" + column.first + ">").c_str());
+		if (column.second->size() != rows)
+			throw exception("Error: batch columns differ in length");
+		for (size_t i = 0; i < constants.size(); ++i)
+			if (constants[i].get() == iter->second.get())
+				poolColumns[i] = column.second->data();
+	}
+
+	column_type<VALUE_TYPE> results(rows);
+	rpn_.run_batch(program_, poolColumns, rows, results.data(), environment_.get());
+	return results;
+}
+
+template PreparedExpression::column_type<real_tier<PRECISION_DOUBLE>::value_type> PreparedExpression::evaluate_batch(column_map_type<real_tier<PRECISION_DOUBLE>::value_type> const&);
+template PreparedExpression::column_type<real_tier<PRECISION_50>::value_type> PreparedExpression::evaluate_batch(column_map_type<real_tier<PRECISION_50>::value_type> const&);
+template PreparedExpression::column_type<real_tier<PRECISION_100>::value_type> PreparedExpression::evaluate_batch(column_map_type<real_tier<PRECISION_100>::value_type> const&);
+template PreparedExpression::column_type<real_tier<PRECISION_1000>::value_type> PreparedExpression::evaluate_batch(column_map_type<real_tier<PRECISION_1000>::value_type> const&);
+
+
+
+Program const* ProgramCache::find(key_type const& key) {
+	auto iter = index_.find(key);
+	if (iter == index_.end()) {
+		++misses_;
+		return nullptr;
+	}
+	++hits_;
+	entries_.splice(entries_.begin(), entries_, iter->second);
+	return &iter->second->second;
+}
+
+
+
+Program const& ProgramCache::insert(key_type const& key, Program program) {
+	auto iter = index_.find(key);
+	if (iter != index_.end()) {
+		iter->second->second = move(program);
+		entries_.splice(entries_.begin(), entries_, iter->second);
+		return entries_.front().second;
+	}
+
+	assert(capacity_ > 0);
+	set_capacity(capacity_ - 1);	// make room
+	capacity_ += 1;
+	entries_.emplace_front(key, move(program));
+	index_.emplace(key, entries_.begin());
+	return entries_.front().second;
+}
+
+
+
+void ProgramCache::clear() {
+	index_.clear();
+	entries_.clear();
+}
+
+
+
+void ProgramCache::set_capacity(size_t capacity) {
+	capacity_ = capacity;
+	while (entries_.size() > capacity_) {
+		index_.erase(entries_.back().first);
+		entries_.pop_back();
+	}
+}
+
+
+
 /*=============================================================
 
 Revision History
 
+Version 3.8.0: 2026-10-18
+evaluate() records each result in the history.
+
+Version 3.7.0: 2026-10-18
+compile() names variables by their interned slots.
+
+Version 3.6.0: 2026-10-18
+Variable values are kept in an Environment.
+
+Version 3.5.0: 2026-10-18
+Added PreparedExpression::evaluate_batch().
+
+Version 3.4.0: 2026-10-18
+Compiled and cached programs are constant folded.
+
+Version 3.3.0: 2026-10-18
+evaluate() can run programs from a ProgramCache.
+
+Version 3.2.0: 2026-10-18
+compile() lowers the expression to bytecode.
+
+Version 3.1.0: 2026-10-18
+Added compile() and PreparedExpression.
+
 Version 3.0.0 2019-11-05
 By Sonia Friesen, Using the Big If
 
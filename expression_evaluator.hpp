@@ -15,7 +15,103 @@
 #include "tokenizer.hpp"
 #include "parser.hpp"
 #include "RPNEvaluator.hpp"
+#include "compiler.hpp"
+#include "environment.hpp"
+#include "result_history.hpp"
 #include "function.hpp"
+#include "variable.hpp"
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+
+/** A compiled expression.
+	Holds the bytecode program and the variables it uses, so it can be evaluated
+	many times without tokenizing or parsing the source again.
+	The variables are those of the ExpressionEvaluator that compiled it, and their values are in its Environment.
+	The program itself is immutable; it can also be evaluated against other environments.
+	*/
+class PreparedExpression {
+public:
+	typedef Token::string_type							name_type;
+	typedef Token::pointer_type							result_type;
+	typedef std::map<name_type, Variable::pointer_type>	variable_map_type;
+
+	/** A column of values of the expression's precision tier, one per row. */
+	template <typename VALUE_TYPE> using column_type = std::vector<VALUE_TYPE>;
+	template <typename VALUE_TYPE> using column_map_type = std::map<name_type, column_type<VALUE_TYPE> const*>;
+private:
+	Program							program_;
+	variable_map_type				variables_;
+	RPNEvaluator					rpn_;
+	std::shared_ptr<Environment>	environment_;
+public:
+	PreparedExpression( Program program, variable_map_type variables, RPNEvaluator rpn, std::shared_ptr<Environment> environment )
+		: program_( std::move( program ) ), variables_( std::move( variables ) ), rpn_( rpn ), environment_( std::move( environment ) ) { }
+
+	/** Sets the value of a variable used by the expression.
+		@note Throws if the expression does not use the variable.
+		*/
+	void		bind( name_type const& name, Operand::pointer_type const& value );
+
+	/** Evaluates the program with the current variable values. */
+	result_type	evaluate() { return rpn_.run( program_, *environment_ ); }
+
+	/** Evaluates the program with the variable values of another environment, indexed by the variables' slots.
+		Threads can evaluate one PreparedExpression against their own environments at the same time. */
+	result_type	evaluate( Environment& environment ) const { return rpn_.run( program_, environment ); }
+
+	/** Evaluates the expression once per row of a batch of columns, keyed by variable name, giving a column of results.
+		Variables without a column keep their current value.  VALUE_TYPE is the value type of the expression's
+		precision tier, e.g. double for PRECISION_DOUBLE.  Each row gives what evaluate() gives with its values bound.
+		@note Throws if a name is not a variable of the expression, the columns differ in length, or a result is not a number.
+		*/
+	template <typename VALUE_TYPE>
+	column_type<VALUE_TYPE>	evaluate_batch( column_map_type<VALUE_TYPE> const& columns );
+
+	Program const&				get_program() const { return program_; }
+	variable_map_type const&	get_variables() const { return variables_; }
+};
+
+
+
+/** Bounded least-recently-used cache of compiled programs, keyed by normalized expression text.
+	A program refers to its variables' tokens, so it always runs with their current values.
+	*/
+class ProgramCache {
+public:
+	typedef Token::string_type		key_type;
+	typedef unsigned long long		counter_type;
+private:
+	typedef std::list<std::pair<key_type, Program>>	entry_list_type;
+
+	entry_list_type												entries_;	// most recently used first
+	std::unordered_map<key_type, entry_list_type::iterator>		index_;
+	size_t														capacity_ = 0;
+	counter_type												hits_ = 0;
+	counter_type												misses_ = 0;
+public:
+	/** Gets the program compiled from 'key' and marks it most recently used, or nullptr.  Counts a hit or a miss. */
+	Program const*	find( key_type const& key );
+
+	/** Adds a program, evicting the least recently used one when full.  The cache must be enabled. */
+	Program const&	insert( key_type const& key, Program program );
+
+	/** Removes every program; the counters are kept. */
+	void			clear();
+
+	/** Sets the number of programs kept.  0 disables the cache. */
+	void			set_capacity( size_t capacity );
+	size_t			get_capacity() const { return capacity_; }
+	size_t			size() const { return entries_.size(); }
+
+	counter_type	get_hits() const { return hits_; }
+	counter_type	get_misses() const { return misses_; }
+};
+
+
 
 class ExpressionEvaluator {
 public:
@@ -24,15 +120,67 @@ public:
 private:
 	Tokenizer		tokenizer_;
 	Parser			parser_;
+	Compiler		compiler_;
 	RPNEvaluator	rpn_;
+	ProgramCache	cache_;
+	std::shared_ptr<Environment>	environment_ = std::make_shared<Environment>();
+	std::shared_ptr<ResultHistory>	history_ = std::make_shared<ResultHistory>();
 public:
+	ExpressionEvaluator() { rpn_.set_history( history_ ); }
+
+	/** Evaluates an expression, recording its result in the history read by result(n).
+		With the program cache enabled, an expression seen before is run from its cached program
+		without being tokenized, parsed or compiled again. */
 	result_type	evaluate( expression_type const& expr );
+
+	/** Tokenizes, parses and compiles an expression once, for repeated evaluation at the current precision.
+		Constant sub-expressions are folded, so they are computed only once. */
+	PreparedExpression	compile( expression_type const& expr );
+
+	/** Selects the precision tier used for Real arithmetic.
+		Cached programs were folded at the old precision, so changing it empties the cache. */
+	void				set_precision( real_precision_type precision );
+	real_precision_type	get_precision() const { return rpn_.get_precision(); }
+
+	/** Sets the number of compiled programs evaluate() keeps.  The cache is off (0) by default. */
+	void						set_cache_capacity( size_t capacity ) { cache_.set_capacity( capacity ); }
+	ProgramCache const&			get_cache() const { return cache_; }
+
+	/** Gets the values of the variables, by slot. */
+	Environment&				get_environment() { return *environment_; }
+
+	/** Gets the results of evaluate(), numbered from 1.  Prepared expressions read the same history. */
+	ResultHistory&				get_history() { return *history_; }
 };
 
 /*=============================================================
 
 Revision History
 
+Version 0.8.0: 2026-10-18
+evaluate() records its results in a ResultHistory.
+
+Version 0.7.0: 2026-10-18
+Variable values are kept in an Environment.
+
+Version 0.6.0: 2026-10-18
+Added PreparedExpression::evaluate_batch().
+
+Version 0.5.0: 2026-10-18
+Compiled and cached programs are constant folded.
+
+Version 0.4.0: 2026-10-18
+Added the ProgramCache used by evaluate().
+
+Version 0.3.0: 2026-10-18
+PreparedExpression holds a bytecode Program.
+
+Version 0.2.0: 2026-10-18
+Added PreparedExpression and compile().
+
+Version 0.1.0: 2026-10-18
+Added set_precision()/get_precision().
+
 Version 0.0.0: 2010-10-31
 Alpha release.
 
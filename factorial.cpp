@@ -0,0 +1,303 @@
+/*! \file		factorial.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Factorial engine implementation.
+	*/
+
+#include "../inc/factorial.hpp"
+#include "../inc/power.hpp"
+#include "../inc/real.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+namespace {
+	using small_type = Integer::small_type;
+	using value_type = Integer::value_type;
+
+	/*! 0! to 20!, the factorials that fit a small_type. */
+	constexpr array<small_type, 21> SMALL_FACTORIALS = [] {
+		array<small_type, 21> table{};
+		table[0] = 1;
+		for (size_t i = 1; i < table.size(); ++i)
+			table[i] = table[i - 1] * small_type(i);
+		return table;
+	}();
+
+	constexpr small_type LAST_SMALL_FACTORIAL = small_type(SMALL_FACTORIALS.size() - 1);
+
+
+
+	/*! The primes up to n, by a sieve of the odd numbers. */
+	vector<uint32_t> primes_to(small_type n) {
+		if (n > small_type(numeric_limits<uint32_t>::max()))
+			throw exception("Error: factorial argument too large");
+
+		vector<uint32_t> primes;
+		if (n < 2)
+			return primes;
+		primes.push_back(2);
+		vector<bool> composite(size_t(n / 2 + 1), false);	// index i is 2i + 1
+		for (small_type i = 1; 2 * i + 1 <= n; ++i) {
+			if (composite[size_t(i)])
+				continue;
+			small_type const p = 2 * i + 1;
+			primes.push_back(uint32_t(p));
+			if (p > n / p)
+				continue;	// p * p is past n, and may not fit a small_type
+			for (small_type j = p * p / 2; 2 * j + 1 <= n; j += p)
+				composite[size_t(j)] = true;
+		}
+		return primes;
+	}
+
+
+	/*! The factors of swing(n) = n! / ((n/2)!)**2: for each prime p, p**e where e counts the odd n / p**k.
+		Each factor is at most n. */
+	vector<uint64_t> swing_factors(small_type n, vector<uint32_t> const& primes) {
+		vector<uint64_t> factors;
+		for (uint32_t p : primes) {
+			if (p > n)
+				break;
+			if (small_type(p) * p <= n) {
+				uint64_t power = 1;
+				for (small_type q = n / p; q > 0; q /= p)
+					if (q & 1)
+						power *= p;
+				if (power > 1)
+					factors.push_back(power);
+			}
+			else if ((n / p) & 1)
+				factors.push_back(p);
+		}
+		return factors;
+	}
+
+
+	/*! Multiplies runs of factors into machine words, so the product tree starts from full words. */
+	vector<uint64_t> pack(vector<uint64_t> const& factors) {
+		vector<uint64_t> words;
+		uint64_t word = 1;
+		for (uint64_t factor : factors) {
+			if (word > numeric_limits<uint64_t>::max() / factor) {
+				words.push_back(word);
+				word = 1;
+			}
+			word *= factor;
+		}
+		if (word > 1)
+			words.push_back(word);
+		return words;
+	}
+
+
+	/*! Product of [first, last) in a balanced tree, so the operands of each multiplication are of similar size. */
+	value_type product(uint64_t const* first, uint64_t const* last) {
+		switch (last - first) {
+		case 0:	return 1;
+		case 1:	return value_type(*first);
+		case 2: {
+			value_type result(first[0]);
+			result *= first[1];
+			return result;
+		}
+		}
+		uint64_t const* middle = first + (last - first) / 2;
+		return product(first, middle) * product(middle, last);
+	}
+
+	value_type product(vector<uint64_t> const& factors) {
+		vector<uint64_t> const words = pack(factors);
+		return product(words.data(), words.data() + words.size());
+	}
+
+
+
+	/*! Bounded cache of factorials, most recently used first.  Values are shared, so a hit is copied outside the lock. */
+	class factorial_cache {
+		struct entry {
+			small_type						n;
+			shared_ptr<value_type const>	value;
+			size_t							bytes;
+		};
+		mutex		guard_;
+		list<entry>	entries_;
+		size_t		maxEntries_ = 16;
+		size_t		maxBytes_ = size_t(64) << 20;
+		size_t		bytes_ = 0;
+
+		void trim() {
+			while (!entries_.empty() && (entries_.size() > maxEntries_ || bytes_ > maxBytes_)) {
+				bytes_ -= entries_.back().bytes;
+				entries_.pop_back();
+			}
+		}
+	public:
+		/*! Finds n!, or else the m! of the largest cached m below n with n - m <= gap ('m' is set); null if neither. */
+		shared_ptr<value_type const> find(small_type n, small_type gap, small_type& m) {
+			lock_guard<mutex> lock(guard_);
+			auto best = entries_.end();
+			for (auto it = entries_.begin(); it != entries_.end(); ++it)
+				if (it->n <= n && n - it->n <= gap && (best == entries_.end() || it->n > best->n))
+					best = it;
+			if (best == entries_.end())
+				return nullptr;
+			entries_.splice(entries_.begin(), entries_, best);
+			m = best->n;
+			return best->value;
+		}
+
+		void insert(small_type n, value_type const& value) {
+			size_t const bytes = value.backend().size() * sizeof(boost::multiprecision::limb_type);
+			lock_guard<mutex> lock(guard_);
+			if (bytes > maxBytes_ || any_of(entries_.begin(), entries_.end(), [n](entry const& e) { return e.n == n; }))
+				return;
+			entries_.push_front(entry{ n, make_shared<value_type const>(value), bytes });
+			bytes_ += bytes;
+			trim();
+		}
+
+		void set_limits(size_t entries, size_t bytes) {
+			lock_guard<mutex> lock(guard_);
+			maxEntries_ = entries;
+			maxBytes_ = bytes;
+			trim();
+		}
+
+		void clear() {
+			lock_guard<mutex> lock(guard_);
+			entries_.clear();
+			bytes_ = 0;
+		}
+	};
+
+	factorial_cache& cache() {
+		static factorial_cache instance;
+		return instance;
+	}
+
+
+
+	/*! n! = ((n/2)!)**2 * swing(n), consulting the cache at each step. */
+	value_type swing_factorial(small_type n, vector<uint32_t> const& primes) {
+		if (n <= LAST_SMALL_FACTORIAL)
+			return SMALL_FACTORIALS[size_t(max<small_type>(n, 0))];
+		small_type m;
+		if (auto hit = cache().find(n, 0, m))
+			return *hit;
+
+		value_type result = swing_factorial(n / 2, primes);
+		result *= result;
+		return result * product(swing_factors(n, primes));
+	}
+
+
+	template <typename REAL>
+	REAL real_swing_factorial(small_type n, vector<uint32_t> const& primes) {
+		if (n <= LAST_SMALL_FACTORIAL)
+			return REAL(SMALL_FACTORIALS[size_t(max<small_type>(n, 0))]);
+
+		REAL result = real_swing_factorial<REAL>(n / 2, primes);
+		result *= result;
+		for (uint64_t word : pack(swing_factors(n, primes)))
+			result *= REAL(word);
+		return result;
+	}
+}
+
+
+
+bool small_factorial(Integer::small_type n, Integer::small_type& result) {
+	if (n > LAST_SMALL_FACTORIAL)
+		return false;
+	result = SMALL_FACTORIALS[size_t(max<small_type>(n, 0))];
+	return true;
+}
+
+
+
+Integer::value_type factorial(Integer::small_type n) {
+	if (n <= LAST_SMALL_FACTORIAL)
+		return SMALL_FACTORIALS[size_t(max<small_type>(n, 0))];
+
+	// log2(n!) = lgamma(n + 1) / ln(2); sized against the same limit as Integer powers
+	if (lgamma(double(n) + 1) / log(2.0) / 8 > double(get_integer_result_limit()))
+		throw exception("Error: factorial result is too large");
+
+	// A cached m! close below n is finished with the product of m+1 .. n.
+	small_type m;
+	value_type result;
+	if (auto hit = cache().find(n, n / 8, m)) {
+		if (m == n)
+			return *hit;
+		vector<uint64_t> factors;
+		for (small_type i = m + 1; i <= n; ++i)
+			factors.push_back(uint64_t(i));
+		result = *hit * product(factors);
+	}
+	else
+		result = swing_factorial(n, primes_to(n));
+
+	cache().insert(n, result);
+	return result;
+}
+
+
+
+template <typename REAL>
+REAL real_factorial(Integer::small_type n) {
+	if (n <= LAST_SMALL_FACTORIAL)
+		return REAL(SMALL_FACTORIALS[size_t(max<small_type>(n, 0))]);
+
+	// Past the range of the type the result is infinite; log10(n!) = lgamma(n + 1) / ln(10)
+	if (lgamma(double(n) + 1) / log(10.0) > double(numeric_limits<REAL>::max_exponent10))
+		return numeric_limits<REAL>::infinity();
+	return real_swing_factorial<REAL>(n, primes_to(n));
+}
+
+template real_tier<PRECISION_DOUBLE>::value_type real_factorial(Integer::small_type);
+template real_tier<PRECISION_50>::value_type real_factorial(Integer::small_type);
+template real_tier<PRECISION_100>::value_type real_factorial(Integer::small_type);
+template real_tier<PRECISION_1000>::value_type real_factorial(Integer::small_type);
+
+
+
+void set_factorial_cache_limits(size_t entries, size_t bytes) {
+	cache().set_limits(entries, bytes);
+}
+
+void clear_factorial_cache() {
+	cache().clear();
+}
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -0,0 +1,60 @@
+#pragma once
+
+/*! \file		factorial.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Factorial engine declaration.
+	*/
+
+#include "integer.hpp"
+#include <cstddef>
+
+
+/*! Gets n! in 'result' and returns true if it fits a small_type (n <= 20), otherwise returns false.  n! is 1 for n < 2. */
+bool small_factorial(Integer::small_type n, Integer::small_type& result);
+
+
+/*! n!, by the prime swing algorithm: n! = ((n/2)!)**2 * swing(n), where swing(n) is a product of prime powers
+	no bigger than n.  The factors of each swing are multiplied in a balanced product tree.
+	Recently computed factorials are kept in a bounded process-wide cache, which also serves the (n/2)! steps;
+	an n a little above a cached m is finished from m!.  Thread-safe.
+	Throws before computing anything if the result would exceed the Integer result limit (see set_integer_result_limit()).
+	*/
+Integer::value_type factorial(Integer::small_type n);
+
+
+/*! n! in a real type, by the same prime swing; each step costs about n / ln(n) small multiplications.
+	Instantiated for the value types of the precision tiers. */
+template <typename REAL>
+REAL real_factorial(Integer::small_type n);
+
+
+/*! Limits of the factorial cache: the number of results and their total size in bytes. */
+void set_factorial_cache_limits(std::size_t entries, std::size_t bytes);
+
+/*! Empties the factorial cache. */
+void clear_factorial_cache();
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
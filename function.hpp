@@ -14,94 +14,119 @@
 #include <vector>
 
 /*! Function token base class. */
-class Function : public Operation { };
+class Function : public Operation {
+	DEF_TOKEN_KIND(Function, Operation, TK_FUNCTION)
+};
 
 		/*! One argument function token base class. */
 		class OneArgFunction : public Function {
+			DEF_TOKEN_KIND(OneArgFunction, Function, TK_ONE_ARG_FUNCTION)
 		public:
 			virtual unsigned number_of_args() const override { return 1; }
 		};
 
 				/*! Absolute value function token. */
-				class Abs : public OneArgFunction {	};
+				class Abs : public OneArgFunction {
+				DEF_OPERATION_ID(OP_ABS)
+				};
 
 				/*! arc cosine function token. */
-				class Arccos : public OneArgFunction {	};
+				class Arccos : public OneArgFunction {
+				DEF_OPERATION_ID(OP_ARCCOS)
+				};
 
 				/*! arc sine function token. */
-				class Arcsin : public OneArgFunction { 
+				class Arcsin : public OneArgFunction {
+				DEF_OPERATION_ID(OP_ARCSIN)
 				};
 
 				/*! arc tangent function token.  Argument is the slope. */
-				class Arctan : public OneArgFunction { 
+				class Arctan : public OneArgFunction {
+				DEF_OPERATION_ID(OP_ARCTAN)
 				};
 
 				/*! ceil function token. */
-				class Ceil : public OneArgFunction { 
+				class Ceil : public OneArgFunction {
+				DEF_OPERATION_ID(OP_CEIL)
 				};
 
 				/*! cosine function token. */
-				class Cos : public OneArgFunction { 
+				class Cos : public OneArgFunction {
+				DEF_OPERATION_ID(OP_COS)
 				};
 
 				/*! exponential function token.  pow(e,x), where 'e' is the euler constant and 'x' is the exponent. */
-				class Exp : public OneArgFunction { 
+				class Exp : public OneArgFunction {
+				DEF_OPERATION_ID(OP_EXP)
 				};
 
 				/*! floor function token. */
-				class Floor : public OneArgFunction { 
+				class Floor : public OneArgFunction {
+				DEF_OPERATION_ID(OP_FLOOR)
 				};
 
 				/*! logarithm base 2 function token. */
 				class Lb : public OneArgFunction {
+				DEF_OPERATION_ID(OP_LB)
 				};
 
 				/*! natural logarithm function token. */
-				class Ln : public OneArgFunction { 
+				class Ln : public OneArgFunction {
+				DEF_OPERATION_ID(OP_LN)
 				};
 
 				/*! logarithm base 10 function token. */
-				class Log : public OneArgFunction { 
+				class Log : public OneArgFunction {
+				DEF_OPERATION_ID(OP_LOG)
 				};
 
-				/*! previous result token. Argument is the 1-base index of the result. */
+				/*! previous result token. Argument is the 1-base index of the result; -1 is the newest. */
 				class Result : public OneArgFunction {
+				DEF_OPERATION_ID(OP_RESULT)
 				};
 
 				/*! sine function token. */
 				class Sin : public OneArgFunction {
+				DEF_OPERATION_ID(OP_SIN)
 				};
 
 				/*! Square root token. */
 				class Sqrt : public OneArgFunction {
+				DEF_OPERATION_ID(OP_SQRT)
 				};
 
 				/*! tangeant function. */
-				class Tan : public OneArgFunction { 
+				class Tan : public OneArgFunction {
+				DEF_OPERATION_ID(OP_TAN)
 				};
 
 
 		/*!	Two argument function token base class. */
 		class TwoArgFunction : public Function {
+			DEF_TOKEN_KIND(TwoArgFunction, Function, TK_TWO_ARG_FUNCTION)
 		public:
 			virtual unsigned number_of_args() const override { return 2; }
 		};
 
 				/*! 2 parameter arc tangent function token.
 					First argument is the change in Y, second argument is the change in X. */
-				class Arctan2 : public TwoArgFunction { 
+				class Arctan2 : public TwoArgFunction {
+				DEF_OPERATION_ID(OP_ARCTAN2)
 				};
 
 				/*! Maximum of 2 elements function token. */
 				class Max : public TwoArgFunction {
+				DEF_OPERATION_ID(OP_MAX)
 				};
 
 				/*! Minimum of 2 elements function token. */
 				class Min : public TwoArgFunction {
+				DEF_OPERATION_ID(OP_MIN)
 				};
 
 				/*! Pow function token.  First argument is the base, second the exponent. */
-				class Pow : public TwoArgFunction { 
+				class Pow : public TwoArgFunction {
+				DEF_OPERATION_ID(OP_POW)
 				};
 
 
@@ -109,6 +134,12 @@ class Function : public Operation { };
 
 Revision History
 
+Version 1.2.0: 2026-10-18
+Added token kinds.
+
+Version 1.1.0: 2026-10-18
+Added operation ids.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
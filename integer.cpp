@@ -12,14 +12,260 @@
 #include "../inc/operator.hpp"
 #include "../inc/boolean.hpp"
 #include "../inc/real.hpp"
-#include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <vector>
 using namespace std;
 
 
 
+Integer::Integer(value_type const& value) : Operand(TK_INTEGER), small_(0), isSmall_(false) {
+	if (value >= numeric_limits<small_type>::min() && value <= numeric_limits<small_type>::max()) {
+		small_ = static_cast<small_type>(value);
+		isSmall_ = true;
+	}
+	else
+		value_ = value;
+}
+
+
+
+Operand::pointer_type make_integer(Integer::small_type value) {
+	constexpr Integer::small_type CACHE_MIN = -128;
+	constexpr Integer::small_type CACHE_MAX = 1024;
+	static array<Operand::pointer_type, CACHE_MAX - CACHE_MIN + 1> const cache = [] {
+		array<Operand::pointer_type, CACHE_MAX - CACHE_MIN + 1> values;
+		for (Integer::small_type v = CACHE_MIN; v <= CACHE_MAX; ++v)
+			values[size_t(v - CACHE_MIN)] = make_operand<Integer>(v);
+		return values;
+	}();
+
+	if (value < CACHE_MIN || value > CACHE_MAX)
+		return make_operand<Integer>(value);
+	return cache[size_t(value - CACHE_MIN)];
+}
+
+
+
+/*! Values are normalized, so a small and a big Integer are never equal. */
+bool Integer::equals(Token const& other) const {
+	auto rhs = dynamic_cast<Integer const*>(&other);
+	if (!rhs || isSmall_ != rhs->isSmall_)
+		return false;
+	return isSmall_ ? small_ == rhs->small_ : value_ == rhs->value_;
+}
+
+
+std::size_t Integer::hash() const {
+	return isSmall_ ? std::hash<small_type>()(small_) : hash_value(value_);
+}
+
+
+
 Integer::string_type Integer::to_string() const {
-	return /*string_type("Integer: ") + */boost::lexical_cast<string_type>(get_value());
+	if (isSmall_)
+		return /*string_type("Integer: ") + */std::to_string(small_);
+	return /*string_type("Integer: ") + */to_decimal(value_);
+}
+
+
+
+namespace {
+	using value_type = Integer::value_type;
+
+	/*! Digits converted directly in a machine word. */
+	constexpr size_t LEAF_DIGITS = 18;
+	constexpr uint64_t LEAF_POWER = 1000000000000000000ull;
+
+	/*! Divisors smaller than this (in bits) are cheaper to divide by than to multiply by their reciprocal. */
+	constexpr unsigned BARRETT_BITS = 4096;
+
+	/*! Pieces with fewer digits than this are not worth a thread. */
+	constexpr size_t PARALLEL_DIGITS = 100000;
+
+
+	/*! Level i of the power cache: 10**(LEAF_DIGITS * 2**i). */
+	struct power_of_ten {
+		value_type	power;
+		value_type	reciprocal;		// floor(2**(2 * bits) / power), for Barrett division; 0 if division is cheaper
+		unsigned	bits;			// of power
+		size_t		digits;			// LEAF_DIGITS * 2**i
+		bool		hasReciprocal = false;
+	};
+
+	using power_list = std::vector<power_of_ten const*>;
+
+
+	/*! floor(2**(2 * bits) / divisor), for a divisor of 'bits' bits.
+		The reciprocal of the top half of the divisor is refined by one Newton step, then corrected exactly. */
+	value_type reciprocal(value_type const& divisor, unsigned bits) {
+		value_type const one = value_type(1) << (2 * bits);
+		if (bits <= BARRETT_BITS)
+			return one / divisor;
+
+		unsigned const high = bits / 2 + 2;
+		value_type x = reciprocal(divisor >> (bits - high), high) << (bits - high);
+
+		// x += x * (one - divisor * x) / one
+		value_type const product = divisor * x;
+		if (product <= one)
+			x += (x * (one - product)) >> (2 * bits);
+		else
+			x -= ((x * (product - one)) >> (2 * bits)) + 1;
+
+		value_type remainder = one - divisor * x;
+		while (remainder < 0) {
+			--x;
+			remainder += divisor;
+		}
+		while (remainder >= divisor) {
+			++x;
+			remainder -= divisor;
+		}
+		return x;
+	}
+
+
+	/*! Gets the first 'count' levels of the process-wide power cache, with reciprocals if asked.
+		Levels are computed on first use only and never move, so the pointers stay valid. */
+	power_list power_levels(size_t count, bool reciprocals) {
+		static std::mutex guard;
+		static std::deque<power_of_ten> levels;
+
+		std::lock_guard<std::mutex> lock(guard);
+		power_list list;
+		for (size_t i = 0; i < count; ++i) {
+			if (i == levels.size()) {
+				power_of_ten level;
+				level.power = i == 0 ? value_type(LEAF_POWER) : levels[i - 1].power * levels[i - 1].power;
+				level.bits = unsigned(msb(level.power)) + 1;
+				level.digits = LEAF_DIGITS << i;
+				levels.push_back(std::move(level));
+			}
+			power_of_ten& level = levels[i];
+			if (reciprocals && !level.hasReciprocal) {
+				if (level.bits > BARRETT_BITS)
+					level.reciprocal = reciprocal(level.power, level.bits);
+				level.hasReciprocal = true;
+			}
+			list.push_back(&level);
+		}
+		return list;
+	}
+
+
+	/*! Splits n (< level.power**2) into n / level.power and n % level.power. */
+	void divide(value_type const& n, power_of_ten const& level, value_type& quotient, value_type& remainder) {
+		if (level.reciprocal.is_zero()) {
+			divide_qr(n, level.power, quotient, remainder);
+			return;
+		}
+		quotient = ((n >> (level.bits - 1)) * level.reciprocal) >> (level.bits + 1);	// at most 3 short
+		remainder = n - quotient * level.power;
+		while (remainder >= level.power) {
+			remainder -= level.power;
+			++quotient;
+		}
+	}
+
+
+	/*! Writes n (< 10**(2 * levels[i]->digits), or < 10**LEAF_DIGITS if i < 0) as exactly that many digits, zero padded. */
+	void write_decimal(value_type const& n, power_list const& levels, int i, char* out, unsigned threads) {
+		if (i < 0) {
+			uint64_t word = n.convert_to<uint64_t>();
+			for (char* p = out + LEAF_DIGITS; p != out; word /= 10)
+				*--p = char('0' + word % 10);
+			return;
+		}
+
+		power_of_ten const& level = *levels[size_t(i)];
+		if (n < level.power) {
+			std::fill(out, out + level.digits, '0');
+			write_decimal(n, levels, i - 1, out + level.digits, threads);
+			return;
+		}
+
+		value_type high, low;
+		divide(n, level, high, low);
+		if (threads > 1 && level.digits >= PARALLEL_DIGITS) {
+			auto task = std::async(std::launch::async, [&] { write_decimal(high, levels, i - 1, out, threads / 2); });
+			write_decimal(low, levels, i - 1, out + level.digits, threads - threads / 2);
+			task.get();
+		}
+		else {
+			write_decimal(high, levels, i - 1, out, 1);
+			write_decimal(low, levels, i - 1, out + level.digits, 1);
+		}
+	}
+
+
+	/*! Reads a string of digits, splitting off the low levels[i]->digits digits while it is longer than that. */
+	value_type read_decimal(std::string_view digits, power_list const& levels, int i, unsigned threads) {
+		while (i >= 0 && levels[size_t(i)]->digits >= digits.size())
+			--i;
+		if (i < 0) {
+			uint64_t word = 0;
+			for (char digit : digits)
+				word = word * 10 + uint64_t(digit - '0');
+			return value_type(word);
+		}
+
+		power_of_ten const& level = *levels[size_t(i)];
+		std::string_view const highDigits = digits.substr(0, digits.size() - level.digits);
+		std::string_view const lowDigits = digits.substr(digits.size() - level.digits);
+		value_type high, low;
+		if (threads > 1 && level.digits >= PARALLEL_DIGITS) {
+			auto task = std::async(std::launch::async, [&] { high = read_decimal(highDigits, levels, i - 1, threads / 2); });
+			low = read_decimal(lowDigits, levels, i - 1, threads - threads / 2);
+			task.get();
+		}
+		else {
+			high = read_decimal(highDigits, levels, i - 1, 1);
+			low = read_decimal(lowDigits, levels, i - 1, 1);
+		}
+		return high * level.power + low;
+	}
+}
+
+
+
+Integer::string_type to_decimal(Integer::value_type const& value, unsigned threads) {
+	value_type const magnitude = abs(value);
+
+	// Up to the smallest level whose square exceeds the magnitude; a level's square is at least 2**(2 * bits - 2).
+	power_list levels;
+	if (magnitude >= LEAF_POWER) {
+		size_t const bits = msb(magnitude) + 1;
+		do
+			levels = power_levels(levels.size() + 1, true);
+		while (2 * size_t(levels.back()->bits) - 2 <= bits);
+	}
+
+	size_t const width = levels.empty() ? LEAF_DIGITS : 2 * levels.back()->digits;
+	Integer::string_type text(width + 1, '0');
+	write_decimal(magnitude, levels, int(levels.size()) - 1, &text[1], threads);
+
+	size_t first = text.find_first_not_of('0', 1);
+	if (first == Integer::string_type::npos)
+		return "0";
+	if (value < 0)
+		text[--first] = '-';
+	text.erase(0, first);
+	return text;
+}
+
+
+
+Integer::value_type from_decimal(std::string_view digits, unsigned threads) {
+	size_t count = 0;
+	while ((LEAF_DIGITS << count) < digits.size())
+		++count;
+	power_list const levels = power_levels(count, false);
+	return read_decimal(digits, levels, int(count) - 1, threads);
 }
 
 
@@ -28,6 +274,21 @@ Integer::string_type Integer::to_string() const {
 
 Revision History
 
+Version 1.5.0: 2026-10-18
+Added to_decimal() and from_decimal(); to_string() no longer uses lexical_cast.
+
+Version 1.4.0: 2026-10-18
+Set the token kind.
+
+Version 1.3.0: 2026-10-18
+Added equals() and hash().
+
+Version 1.2.0: 2026-10-18
+Added make_integer().
+
+Version 1.1.0: 2026-10-18
+Integer values that fit in small_type are stored inline.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -11,29 +11,115 @@
 
 #include "operand.hpp"
 #include <boost/multiprecision/cpp_int.hpp>
+#include <cassert>
+#include <limits>
+#include <string_view>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
-/*! Integer token. */
+/*! Integer token.
+	Values that fit in a small_type are held inline; only larger values use the arbitrary precision value_type.
+	The representation is invisible to users: get_value() always returns the exact value. */
 class Integer : public Operand {
 public:
 	using value_type = boost::multiprecision::cpp_int;
+	using small_type = long long;
 	DEF_POINTER_TYPE(Integer)
+	static constexpr token_kind_type KIND = Operand::KIND | TK_INTEGER;
 private:
-	value_type	value_;
+	small_type	small_;
+	value_type	value_;		// only used when !isSmall_
+	bool		isSmall_;
 public:
-	Integer( value_type value = 0 )
-		: value_( value ) { }
+	Integer( small_type value = 0 )
+		: Operand( TK_INTEGER ), small_( value ), isSmall_( true ) { }
+	Integer( value_type const& value );
 
-	value_type				get_value() const { return value_; }
+	value_type				get_value() const { return isSmall_ ? value_type( small_ ) : value_; }
+	bool					is_small() const { return isSmall_; }
+	small_type				get_small() const { assert( isSmall_ ); return small_; }
 	string_type				to_string() const;
+	bool					equals(Token const& other) const override;
+	std::size_t				hash() const override;
 };
 
 
 
+/*! Makes an Integer operand.  Values from -128 to 1024 share cached instances. */
+Operand::pointer_type make_integer(Integer::small_type value);
+
+
+
+/*! Decimal conversion of Integer values, by divide and conquer over cached powers of ten.
+	Splits use Barrett division by the cached powers' reciprocals, so big values convert in subquadratic time.
+	With 'threads' > 1, the halves of values of hundreds of thousands of digits are converted in parallel. */
+Integer::string_type to_decimal(Integer::value_type const& value, unsigned threads = 1);
+
+/*! Parses a string of decimal digits, which may have leading zeros. */
+Integer::value_type from_decimal(std::string_view digits, unsigned threads = 1);
+
+
+
+/*! Overflow checked small_type arithmetic.
+	Each stores the result in 'result' and returns true, or returns false if the result does not fit. */
+inline bool checked_add( Integer::small_type lhs, Integer::small_type rhs, Integer::small_type& result ) {
+#if defined(__GNUC__) || defined(__clang__)
+	return !__builtin_add_overflow( lhs, rhs, &result );
+#else
+	if ( (rhs > 0 && lhs > std::numeric_limits<Integer::small_type>::max() - rhs) ||
+		(rhs < 0 && lhs < std::numeric_limits<Integer::small_type>::min() - rhs) )
+		return false;
+	result = lhs + rhs;
+	return true;
+#endif
+}
+
+inline bool checked_subtract( Integer::small_type lhs, Integer::small_type rhs, Integer::small_type& result ) {
+#if defined(__GNUC__) || defined(__clang__)
+	return !__builtin_sub_overflow( lhs, rhs, &result );
+#else
+	if ( (rhs < 0 && lhs > std::numeric_limits<Integer::small_type>::max() + rhs) ||
+		(rhs > 0 && lhs < std::numeric_limits<Integer::small_type>::min() + rhs) )
+		return false;
+	result = lhs - rhs;
+	return true;
+#endif
+}
+
+inline bool checked_multiply( Integer::small_type lhs, Integer::small_type rhs, Integer::small_type& result ) {
+#if defined(__GNUC__) || defined(__clang__)
+	return !__builtin_mul_overflow( lhs, rhs, &result );
+#else
+	Integer::small_type high;
+	result = _mul128( lhs, rhs, &high );
+	return high == (result < 0 ? -1 : 0);
+#endif
+}
+
+
+
 /*=============================================================
 
 Revision History
 
+Version 1.5.0: 2026-10-18
+Added to_decimal() and from_decimal().
+
+Version 1.4.0: 2026-10-18
+Added token kind.
+
+Version 1.3.0: 2026-10-18
+Added value equality and hashing.
+
+Version 1.2.0: 2026-10-18
+Added make_integer() with a small value cache.
+
+Version 1.1.0: 2026-10-18
+Values that fit in a long long are held inline.
+Added overflow checked small integer arithmetic.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
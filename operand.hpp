@@ -17,6 +17,7 @@
 
 /*! Operand token base class. */
 class Operand : public Token {
+	DEF_TOKEN_KIND(Operand, Token, TK_OPERAND)
 public:
 	DEF_POINTER_TYPE(Operand)
 	using operand_list_type = std::deque<Operand::pointer_type>;
@@ -46,6 +47,9 @@ using OperandList = Operand::operand_list_type;
 
 Revision History
 
+Version 1.1.0: 2026-10-18
+Added token kind.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
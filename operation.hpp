@@ -15,13 +15,38 @@
 #include "operand.hpp"
 
 
+/*! Operation identifiers, one per concrete operator and function class.
+	Used to index the evaluator's kernel table.  OP_COUNT means 'no kernel'. */
+enum operation_id_type {
+	// operators
+	OP_POWER, OP_ASSIGNMENT,
+	OP_ADDITION, OP_AND, OP_DIVISION, OP_EQUALITY, OP_GREATER, OP_GREATER_EQUAL,
+	OP_INEQUALITY, OP_LESS, OP_LESS_EQUAL, OP_MULTIPLICATION, OP_MODULUS, OP_NAND,
+	OP_NOR, OP_OR, OP_SUBTRACTION, OP_XOR, OP_XNOR,
+	OP_IDENTITY, OP_NEGATION, OP_NOT, OP_FACTORIAL,
+	// functions
+	OP_ABS, OP_ARCCOS, OP_ARCSIN, OP_ARCTAN, OP_CEIL, OP_COS, OP_EXP, OP_FLOOR,
+	OP_LB, OP_LN, OP_LOG, OP_RESULT, OP_SIN, OP_SQRT, OP_TAN,
+	OP_ARCTAN2, OP_MAX, OP_MIN, OP_POW,
+	OP_COUNT };
+
+
+
+/*! Defines an operation id method.  Used inside a concrete operation class declaration. */
+#define DEF_OPERATION_ID(id)	public: static constexpr operation_id_type OPERATION_ID = id; \
+								operation_id_type get_operation_id() const override { return id; }
+
+
+
 /*! Operation token base class. */
 class Operation : public Token {
+	DEF_TOKEN_KIND(Operation, Token, TK_OPERATION)
 public:
 	DEF_POINTER_TYPE(Operation)
+	using operation_type = Operation;
 
 	virtual unsigned number_of_args() const = 0;
-		
+	virtual operation_id_type get_operation_id() const { return OP_COUNT; }
 };
 
 
@@ -31,6 +56,12 @@ public:
 
 Revision History
 
+Version 1.2.0: 2026-10-18
+Added token kind and OPERATION_ID.
+
+Version 1.1.0: 2026-10-18
+Added operation_id_type and get_operation_id().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -29,6 +29,7 @@ enum precedence_type { MIN = 0,
 
 /*! Operator token base class. */
 class Operator : public Operation {
+	DEF_TOKEN_KIND(Operator, Operation, TK_OPERATOR)
 public:
 	DEF_POINTER_TYPE(Operator)
 	virtual precedence_type get_precedence() const = 0;
@@ -36,149 +37,185 @@ public:
 
 		/*! Binary operator token base class. */
 		class BinaryOperator : public Operator {
+			DEF_TOKEN_KIND(BinaryOperator, Operator, TK_BINARY_OPERATOR)
 		public:
 			virtual unsigned number_of_args() const override { return 2; }
 		};
 
 				/*! Right-associative operator base class. */
-				class RAssocOperator : public BinaryOperator { };
+				class RAssocOperator : public BinaryOperator {
+				DEF_TOKEN_KIND(RAssocOperator, BinaryOperator, TK_RASSOC_OPERATOR)
+				};
 
 						/*! Power token. */
 						class Power : public RAssocOperator {
 						DEF_PRECEDENCE(POWER)
+						DEF_OPERATION_ID(OP_POWER)
 						};
 
 						/*! Assignment token. */
 						class Assignment : public RAssocOperator {
 						DEF_PRECEDENCE(ASSIGNMENT)
+						DEF_OPERATION_ID(OP_ASSIGNMENT)
 						};
 
 
 				/*! Left-associative operator base class. */
-				class LAssocOperator : public BinaryOperator {};
+				class LAssocOperator : public BinaryOperator {
+				DEF_TOKEN_KIND(LAssocOperator, BinaryOperator, TK_LASSOC_OPERATOR)
+				};
 
 						/*! Addition token. */
 						class Addition : public LAssocOperator {
 						DEF_PRECEDENCE(ADDITIVE)
+						DEF_OPERATION_ID(OP_ADDITION)
 						};
 
 						/*! And token. */
 						class And : public LAssocOperator {
 						DEF_PRECEDENCE(LOGAND)
+						DEF_OPERATION_ID(OP_AND)
 						};
 
 						/*! Division token. */
 						class Division : public LAssocOperator {
 						DEF_PRECEDENCE(MULTIPLICATIVE)
+						DEF_OPERATION_ID(OP_DIVISION)
 						};
 
 						/*! Equality token. */
 						class Equality : public LAssocOperator {
 						DEF_PRECEDENCE(EQUALITY)
+						DEF_OPERATION_ID(OP_EQUALITY)
 						};
 
 						/*! Greater than token. */
 						class Greater : public LAssocOperator {
 						DEF_PRECEDENCE(RELATIONAL)
+						DEF_OPERATION_ID(OP_GREATER)
 						};
 
 						/*! Greater than or equal to token. */
 						class GreaterEqual : public LAssocOperator {
 						DEF_PRECEDENCE(RELATIONAL)
+						DEF_OPERATION_ID(OP_GREATER_EQUAL)
 						};
 
 						/*! Inequality operator token. */
 						class Inequality : public LAssocOperator {
 						DEF_PRECEDENCE(EQUALITY)
+						DEF_OPERATION_ID(OP_INEQUALITY)
 						};
 
 						/*! Less than operator token. */
 						class Less : public LAssocOperator {
 						DEF_PRECEDENCE(RELATIONAL)
+						DEF_OPERATION_ID(OP_LESS)
 						};
 
 						/*! Less than equal-to operator token. */
 						class LessEqual : public LAssocOperator {
 						DEF_PRECEDENCE(RELATIONAL)
+						DEF_OPERATION_ID(OP_LESS_EQUAL)
 						};
 
 						/*! Multiplication operator token. */
 						class Multiplication : public LAssocOperator {
 						DEF_PRECEDENCE(MULTIPLICATIVE)
+						DEF_OPERATION_ID(OP_MULTIPLICATION)
 						};
 
 						/*! Modulus operator token. */
 						class Modulus : public LAssocOperator {
 						DEF_PRECEDENCE(MULTIPLICATIVE)
+						DEF_OPERATION_ID(OP_MODULUS)
 						};
 
 						/*! Nand operator token. */
 						class Nand : public LAssocOperator {
 						DEF_PRECEDENCE(LOGAND)
+						DEF_OPERATION_ID(OP_NAND)
 						};
 
 						/*! Nor operator token. */
 						class Nor : public LAssocOperator {
 						DEF_PRECEDENCE(LOGOR)
+						DEF_OPERATION_ID(OP_NOR)
 						};
 
 						/*! Or operator token. */
 						class Or : public LAssocOperator {
 						DEF_PRECEDENCE(LOGOR)
+						DEF_OPERATION_ID(OP_OR)
 						};
 
 						/*! Subtraction operator token. */
 						class Subtraction : public LAssocOperator {
 						DEF_PRECEDENCE(ADDITIVE)
+						DEF_OPERATION_ID(OP_SUBTRACTION)
 						};
 
 						/*! XOR operator token. */
 						class Xor : public LAssocOperator {
 						DEF_PRECEDENCE(LOGOR)
+						DEF_OPERATION_ID(OP_XOR)
 						};
 
 						/*! XNOR operator token. */
 						class Xnor : public LAssocOperator {
 						DEF_PRECEDENCE(LOGOR)
+						DEF_OPERATION_ID(OP_XNOR)
 
 						};
 
 
 		/*! Non-associative operator token base class. */
-		class NonAssociative : public Operator { };
+		class NonAssociative : public Operator {
+		DEF_TOKEN_KIND(NonAssociative, Operator, TK_NON_ASSOCIATIVE)
+		};
 
 				/*! Unary operator token base class. */
 				class UnaryOperator : public NonAssociative {
+				DEF_TOKEN_KIND(UnaryOperator, NonAssociative, TK_UNARY_OPERATOR)
 				public: virtual unsigned number_of_args() const override { return 1; }
 				DEF_PRECEDENCE(UNARY)
 				};
 
 						/*! Identity operator token. */
 						class Identity : public UnaryOperator {
-						public:
+						DEF_OPERATION_ID(OP_IDENTITY)
 						};
 
 						/*! Negation operator token. */
 						class Negation : public UnaryOperator {
-						public:
+						DEF_OPERATION_ID(OP_NEGATION)
 						};
 
 						/*! Not operator token. */
 						class Not : public UnaryOperator {
+						DEF_OPERATION_ID(OP_NOT)
 						};
 
 				/*! Postfix Operator token base class. */
-				class PostfixOperator : public UnaryOperator { 
+				class PostfixOperator : public UnaryOperator {
+				DEF_TOKEN_KIND(PostfixOperator, UnaryOperator, TK_POSTFIX_OPERATOR)
 				};
 
 						/*! Factorial token base class. */
 						class Factorial : public PostfixOperator {
+						DEF_OPERATION_ID(OP_FACTORIAL)
 						};
 
 /*=============================================================
 
 Revision History
 
+Version 1.1.0: 2026-10-18
+Added token kinds.
+
+Version 1.1.0: 2026-10-18
+Added operation ids.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
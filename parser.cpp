@@ -13,123 +13,116 @@
 #include "../inc/operand.hpp"
 #include "../inc/operator.hpp"
 #include "../inc/pseudo_operation.hpp"
-#include <stack>
+#include <array>
+#include <vector>
 using namespace std;
 
+namespace {
+	/*! Precedence of each operator, indexed by operation id.  Read once from the operator classes. */
+	array<precedence_type, OP_COUNT> const& precedence_table() {
+		static array<precedence_type, OP_COUNT> const table = [] {
+			array<precedence_type, OP_COUNT> precedences;
+			precedences.fill(MIN);
+			for (auto const& tkn : {
+					make<Power>(), make<Assignment>(),
+					make<Addition>(), make<And>(), make<Division>(), make<Equality>(), make<Greater>(), make<GreaterEqual>(),
+					make<Inequality>(), make<Less>(), make<LessEqual>(), make<Multiplication>(), make<Modulus>(), make<Nand>(),
+					make<Nor>(), make<Or>(), make<Subtraction>(), make<Xor>(), make<Xnor>(),
+					make<Identity>(), make<Negation>(), make<Not>(), make<Factorial>() }) {
+				auto op = static_cast<Operator const*>(tkn.get());
+				precedences[op->get_operation_id()] = op->get_precedence();
+			}
+			return precedences;
+		}();
+		return table;
+	}
+
+	/*! Operation stack entry.  Points into the infix list, which outlives the parse. */
+	struct pending_operation {
+		Token::pointer_type const*	token;
+		token_kind_type				kind;
+		precedence_type				precedence;
+	};
+}
+
+
+
 //start here
 TokenList Parser::parse(TokenList const& infixTokens) {
-	
-	//1.create a empty stack and TokenList
-	stack<Token::pointer_type> stackOperation;
+	auto const& precedences = precedence_table();
+
+	//1.create a empty stack and TokenList, each sized for the whole input
+	vector<pending_operation> stackOperation;
+	stackOperation.reserve(infixTokens.size());
 	TokenList postFix;
+	postFix.reserve(infixTokens.size());
+
+	//pop operations to the postfix list until a left parenthesis is on top
+	auto unwind_to_left_parenthesis = [&](char const* error) {
+		while (!stackOperation.empty() && !(stackOperation.back().kind & TK_LEFT_PARENTHESIS)) {
+			postFix.push_back(*stackOperation.back().token);
+			stackOperation.pop_back();
+		}
+		if (stackOperation.empty())
+			throw(error);
+	};
 
 	//use a ranged for loop to go through the tokens in list
-	for (auto t : infixTokens)
+	for (auto const& t : infixTokens)
 	{
+		auto kind = t->get_kind();
+
 		//is it a operand?
-		if (auto operand = dynamic_pointer_cast<Operand>(t)) {
+		if (kind & TK_OPERAND) {
 			postFix.push_back(t);
 		}//end oeprand
-		//is it a function
-		else if (auto function = dynamic_pointer_cast<Function>(t)) {
-			stackOperation.push(t);
+		//is it a function or a left parenthesis
+		else if (kind & (TK_FUNCTION | TK_LEFT_PARENTHESIS)) {
+			stackOperation.push_back({ &t, kind, MIN });
 		}//end function
 		//is it a Argument Separator
-		else if (auto arguSep = dynamic_pointer_cast<ArgumentSeparator>(t))
-		{
-			while (!dynamic_pointer_cast<LeftParenthesis>(stackOperation.top())) { //is not a left parenthesis
-				postFix.push_back(stackOperation.top()); //add to queue
-				if (!stackOperation.empty())
-					stackOperation.pop();//pop it off the top
-			} //end while loop
+		else if (kind & TK_ARGUMENT_SEPARATOR) {
+			unwind_to_left_parenthesis("Argument separator outside of a function call");
 		}//end argument seperator
-		//is it a left parenthesis
-		else if (auto leftParnth = dynamic_pointer_cast<LeftParenthesis>(t))
-		{
-			stackOperation.push(t);
-		}//end left parenthesis
-		else if (auto rightParnth = dynamic_pointer_cast<RightParenthesis>(t))
-		{
-			while (!dynamic_pointer_cast<LeftParenthesis>(stackOperation.top())) //if its not a leftparenthesis
-			{
-				postFix.push_back(stackOperation.top()); //pushit on postFix list
-				if (!stackOperation.empty()){
-					stackOperation.pop(); //take off stack
-				}
-				if (stackOperation.empty())
-				{
-					//exception handling
-					throw("Right parenthesis, has no matching left parenthesis");
-					break;
-				}//end if
-			}//end while
+		else if (kind & TK_RIGHT_PARENTHESIS) {
+			unwind_to_left_parenthesis("Right parenthesis, has no matching left parenthesis");
 			//take parenthesis off the stack
-			if (!stackOperation.empty()){
-				stackOperation.pop();
-			}//end if
-			if (!stackOperation.empty()) {
-				//if its a function, push to postFix and pop off stack.
-				if (auto function = dynamic_pointer_cast<Function>(stackOperation.top())) {
-					postFix.push_back(stackOperation.top());
-					stackOperation.pop();
-				}//end if
+			stackOperation.pop_back();
+			//if its a function, push to postFix and pop off stack.
+			if (!stackOperation.empty() && (stackOperation.back().kind & TK_FUNCTION)) {
+				postFix.push_back(*stackOperation.back().token);
+				stackOperation.pop_back();
 			}//end if
 		}//right parenthesis
 		//is it an operator, if so what is the precedence
-		else if (auto isoperator = dynamic_pointer_cast<Operator>(t)) {
-			//use a loop until we have an empty stack
-			while (!stackOperation.empty()) {
-				//check the top for operator
-				if (!dynamic_pointer_cast<Operator>(stackOperation.top())) {
-					//exit out of loop
-					break;
-				}
-				if (dynamic_pointer_cast<NonAssociative>(t)) // if its non associative
-				{
-					//exit loop
-					break;
-				}
-				if (auto assocOperator = dynamic_pointer_cast<LAssocOperator>(t)) {
-					auto isoperator = dynamic_pointer_cast<Operator>(stackOperation.top());
+		else if (kind & TK_OPERATOR) {
+			auto precedence = precedences[static_cast<Operator const*>(t.get())->get_operation_id()];
+			//non associative operators never pop the stack
+			if (!(kind & TK_NON_ASSOCIATIVE)) {
+				bool rightAssoc = (kind & TK_RASSOC_OPERATOR) != 0;
+				while (!stackOperation.empty() && (stackOperation.back().kind & TK_OPERATOR)) {
 					//if the token has a high precedence then the top of the stack
-					if (assocOperator->get_precedence() > isoperator->get_precedence()) {
-						//exit loop
+					auto topPrecedence = stackOperation.back().precedence;
+					if (precedence > topPrecedence || (rightAssoc && precedence == topPrecedence))
 						break;
-					}
-				}
-				if (auto rAssocOperator = dynamic_pointer_cast<RAssocOperator>(t)) {
-					auto isoperator = dynamic_pointer_cast<Operator>(stackOperation.top());
-					//if the token has a high precedence then the top of the stack
-					if (rAssocOperator->get_precedence() >= isoperator->get_precedence()) {
-						//exit loop
-						break;
-					}
-				}
-				//the top of the stak should have the hiest precedence, pus it to the postfix and take off
-				postFix.push_back(stackOperation.top());				
-				//check to make sure the stack isnt empty
-				if (!stackOperation.empty())
-				{
-					stackOperation.pop();
-				}				
-			}//end while loop
-			stackOperation.push(t);//push that token on to the stack
+					//the top of the stak should have the hiest precedence, pus it to the postfix and take off
+					postFix.push_back(*stackOperation.back().token);
+					stackOperation.pop_back();
+				}//end while loop
+			}
+			stackOperation.push_back({ &t, kind, precedence });//push that token on to the stack
 		}//end else if operator
 		else {
 			throw("Unknown token");
-			break;
 		}
 	}//end auto for loop
 
 	//go through stack, add each operation, and pop them off the stack
 	while (!stackOperation.empty()) { //while the stack is not empty
-		if (auto leftParnth = dynamic_pointer_cast<LeftParenthesis>(stackOperation.top()))
-		{
+		if (stackOperation.back().kind & TK_LEFT_PARENTHESIS)
 			throw("Missing right-parenthesis");
-			break;
-		}
-		postFix.push_back(stackOperation.top()); //push the top of th estack
-		stackOperation.pop(); //remove the operation
+		postFix.push_back(*stackOperation.back().token); //push the top of th estack
+		stackOperation.pop_back(); //remove the operation
 	}
 	//return the toeklist
 	return postFix;
@@ -140,6 +133,10 @@ TokenList Parser::parse(TokenList const& infixTokens) {
 
 Revision History
 
+Version 3.1.0: 2026-10-18
+Table driven: precedence comes from a table indexed by operation id and associativity from the token kind.
+The operation stack is a preallocated vector and the output is reserved from the input size.
+
 Version 3.0.0 2019-11-05
 By Sonia Friesen, Using the Big If
 
@@ -0,0 +1,102 @@
+/*! \file		power.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Integer exponentiation implementation.
+	*/
+
+#include "../inc/power.hpp"
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+using namespace std;
+
+namespace {
+	using value_type = Integer::value_type;
+
+	atomic<size_t> resultLimit(size_t(256) << 20);
+
+	/*! log2 of a positive value, from its top 53 bits. */
+	double log2_of(value_type const& magnitude) {
+		unsigned const top = unsigned(msb(magnitude));
+		if (top < 53)
+			return log2(magnitude.convert_to<double>());
+		return top - 52 + log2((magnitude >> (top - 52)).convert_to<double>());
+	}
+}
+
+
+
+size_t integer_power_bytes(Integer::value_type const& base, Integer::value_type const& exponent) {
+	value_type const magnitude = abs(base);
+	if (magnitude <= 1 || exponent <= 0)
+		return 0;
+	double const bytes = ceil(exponent.convert_to<double>() * log2_of(magnitude) / 8);
+	return bytes < double(numeric_limits<size_t>::max()) ? size_t(bytes) : numeric_limits<size_t>::max();
+}
+
+
+
+Integer::value_type integer_power(Integer::value_type const& base, Integer::value_type const& exponent) {
+	if (exponent == 0)
+		return 1;
+	if (base == 0 || base == 1)
+		return base;
+	if (base == -1)
+		return bit_test(exponent, 0) ? -1 : 1;
+	if (integer_power_bytes(base, exponent) > resultLimit)
+		throw exception("Error: Integer power is too large");
+
+	// The limit keeps the exponent well inside an unsigned long long.
+	unsigned long long const e = exponent.convert_to<unsigned long long>();
+	value_type const magnitude = abs(base);
+	unsigned const twos = unsigned(lsb(magnitude));
+	value_type const odd = magnitude >> twos;
+
+	value_type result = 1;
+	if (odd != 1)
+		for (int bit = int(msb(exponent)); bit >= 0; --bit) {
+			result *= result;
+			if ((e >> bit) & 1)
+				result *= odd;
+		}
+	result <<= twos * e;
+
+	if (base < 0 && (e & 1))
+		result = -result;
+	return result;
+}
+
+
+
+void set_integer_result_limit(size_t bytes) {
+	resultLimit = bytes;
+}
+
+size_t get_integer_result_limit() {
+	return resultLimit;
+}
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -0,0 +1,51 @@
+#pragma once
+
+/*! \file		power.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		Integer exponentiation declaration.
+	*/
+
+#include "integer.hpp"
+#include <cstddef>
+
+
+/*! Estimates the bytes of |base| ** exponent from the logarithm of the base, without computing it.
+	Bases 0 and 1 need none; the estimate saturates at SIZE_MAX. */
+std::size_t integer_power_bytes(Integer::value_type const& base, Integer::value_type const& exponent);
+
+
+/*! base ** exponent for exponent >= 0.  Bases 0, 1 and -1 take any exponent; powers of two are shifted;
+	other bases are raised by left-to-right square-and-multiply, with their factors of two shifted in at the end.
+	Throws before computing anything if the result would exceed the Integer result limit.
+	*/
+Integer::value_type integer_power(Integer::value_type const& base, Integer::value_type const& exponent);
+
+
+/*! The largest Integer power, in bytes, that integer_power() computes.  The default is 256 MiB. */
+void		set_integer_result_limit(std::size_t bytes);
+std::size_t	get_integer_result_limit();
+
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -13,19 +13,29 @@
 
 
 /*! Pseudo-operation token base class. */
-class PseudoOperation : public Token { };
+class PseudoOperation : public Token {
+	DEF_TOKEN_KIND(PseudoOperation, Token, TK_PSEUDO_OPERATION)
+};
 
 		/*! Parenthesis operation token base class. */
-		class Parenthesis : public PseudoOperation { };
+		class Parenthesis : public PseudoOperation {
+		DEF_TOKEN_KIND(Parenthesis, PseudoOperation, TK_PARENTHESIS)
+		};
 
 				/*! Left-parenthesis token. */
-				class LeftParenthesis : public Parenthesis { };
+				class LeftParenthesis : public Parenthesis {
+				DEF_TOKEN_KIND(LeftParenthesis, Parenthesis, TK_LEFT_PARENTHESIS)
+				};
 
 				/*! Right-parenthesis token. */
-				class RightParenthesis : public Parenthesis { };
+				class RightParenthesis : public Parenthesis {
+				DEF_TOKEN_KIND(RightParenthesis, Parenthesis, TK_RIGHT_PARENTHESIS)
+				};
 
 		/*! Argument-separator operation token. */
-		class ArgumentSeparator : public PseudoOperation { };
+		class ArgumentSeparator : public PseudoOperation {
+		DEF_TOKEN_KIND(ArgumentSeparator, PseudoOperation, TK_ARGUMENT_SEPARATOR)
+		};
 
 
 
@@ -34,6 +44,9 @@ class PseudoOperation : public Token { };
 
 Revision History
 
+Version 1.1.0: 2026-10-18
+Added token kinds.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -12,17 +12,271 @@
 #include "../inc/function.hpp"
 #include "../inc/operator.hpp"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
+#include <cstdint>
+#include <cstdlib>
 using namespace std;
 
 
 Real::string_type Real::to_string() const {
-	ostringstream oss;
-	oss << /*"Real: " << */fixed << setprecision(numeric_limits<value_type>::digits10) << value_;
-	return oss.str();
+	return /*"Real: " + */format_real(value_, FORMAT_FIXED, numeric_limits<value_type>::digits10);
+}
+
+
+/*! Pi and E are Reals, so they equal a Real of the same value. */
+bool Real::equals(Token const& other) const {
+	auto rhs = dynamic_cast<Real const*>(&other);
+	return rhs && value_ == rhs->value_;
+}
+
+
+std::size_t Real::hash() const {
+	return value_.is_zero() ? 0 : hash_value(value_);	// -0 == 0
+}
+
+
+
+unsigned digits_of(real_precision_type precision) {
+	switch (precision) {
+	case PRECISION_DOUBLE:	return numeric_limits<real_tier<PRECISION_DOUBLE>::value_type>::digits10;
+	case PRECISION_50:		return numeric_limits<real_tier<PRECISION_50>::value_type>::digits10;
+	case PRECISION_100:		return numeric_limits<real_tier<PRECISION_100>::value_type>::digits10;
+	default:				return numeric_limits<real_tier<PRECISION_1000>::value_type>::digits10;
+	}
+}
+
+
+real_precision_type precision_for_digits(unsigned digits) {
+	for (int p = PRECISION_DOUBLE; p < PRECISION_1000; ++p)
+		if (digits <= digits_of(real_precision_type(p)))
+			return real_precision_type(p);
+	return PRECISION_1000;
+}
+
+
+namespace {
+	template <typename REAL>
+	unsigned round_trip_digits_of(Real::value_type const& value) {
+		using limits = numeric_limits<REAL>;
+		if (value.is_zero() || !boost::multiprecision::isfinite(value))
+			return limits::digits10;
+
+		REAL const target = value.convert_to<REAL>();
+		for (unsigned digits = limits::digits10; digits < unsigned(limits::max_digits10); ++digits) {
+			Real::string_type const text = format_real(value, FORMAT_SCIENTIFIC, digits - 1);
+			REAL readBack;
+			if constexpr (is_same_v<REAL, double>)
+				readBack = strtod(text.c_str(), nullptr);
+			else
+				readBack = REAL(text);
+			if (readBack == target)
+				return digits;
+		}
+		return limits::max_digits10;
+	}
+}
+
+
+unsigned round_trip_digits(Real::value_type const& value, real_precision_type precision) {
+	switch (precision) {
+	case PRECISION_DOUBLE:	return round_trip_digits_of<real_tier<PRECISION_DOUBLE>::value_type>(value);
+	case PRECISION_50:		return round_trip_digits_of<real_tier<PRECISION_50>::value_type>(value);
+	case PRECISION_100:		return round_trip_digits_of<real_tier<PRECISION_100>::value_type>(value);
+	default:				return round_trip_digits_of<real_tier<PRECISION_1000>::value_type>(value);
+	}
+}
+
+
+
+namespace {
+	using value_type = Real::value_type;
+
+	/*! Significant digits a value_type holds; places past them are written as zeros. */
+	constexpr int MAX_DIGITS = numeric_limits<value_type>::max_digits10;
+
+	/*! Leading decimal digits of a magnitude, which is 0.d0d1d2... * 10**(exponent + 1). */
+	struct decimal_digits {
+		array<char, MAX_DIGITS + 1> digits;	// one spare for the rounding digit
+		int count = 0;
+		int exponent = 0;
+
+		/*! Digit with place value 10**(exponent - i); '0' outside the stored digits. */
+		char operator[](long long i) const { return i >= 0 && i < count ? digits[size_t(i)] : '0'; }
+	};
+
+
+	/*! 10**exponent, which is exact in a decimal float. */
+	value_type power_of_ten(int exponent) {
+		char text[16] = { '1', 'e' };
+		*to_chars(text + 2, text + sizeof(text) - 1, exponent).ptr = '\0';
+		return value_type(text);
+	}
+
+
+	/*! Gets the first 'count' significant digits of 'magnitude' (> 0), rounded half away from zero.
+		The digits are peeled off eight at a time from the normalized fraction. */
+	decimal_digits leading_digits(value_type const& magnitude, long long count) {
+		decimal_digits d;
+		d.exponent = int(magnitude.backend().order());
+		if (count < 0)
+			return d;	// below the last place: rounds to zero
+		int const wanted = int(min<long long>(count, MAX_DIGITS));
+
+		value_type m = magnitude * power_of_ten(-d.exponent);	// 1 <= m < 10
+		unsigned lead = m.convert_to<unsigned>();
+		assert(lead >= 1 && lead <= 9);
+		m -= lead;
+		int n = 0;
+		d.digits[n++] = char('0' + lead);
+		while (n <= wanted) {
+			m *= 100000000u;
+			uint32_t chunk = m.convert_to<uint32_t>();
+			m -= chunk;
+			char text[8];
+			for (int i = 7; i >= 0; --i, chunk /= 10)
+				text[i] = char('0' + chunk % 10);
+			for (int i = 0; i < 8 && n <= wanted; ++i)
+				d.digits[n++] = text[i];
+		}
+
+		d.count = wanted;
+		if (d.digits[size_t(wanted)] >= '5') {
+			int i = wanted - 1;
+			while (i >= 0 && d.digits[size_t(i)] == '9')
+				d.digits[size_t(i--)] = '0';
+			if (i >= 0)
+				++d.digits[size_t(i)];
+			else {	// 99.9 -> 100.0, or a lone rounding digit -> 1
+				d.digits[0] = '1';
+				d.count = max(d.count, 1);
+				++d.exponent;
+			}
+		}
+		return d;
+	}
+
+
+	/*! Bounded output cursor; remembers whether anything was dropped. */
+	struct text_writer {
+		char* next;
+		char* last;
+		bool full = false;
+
+		text_writer(char* first, char* last) : next(first), last(last) { }
+		void put(char c) {
+			if (next == last)
+				full = true;
+			else
+				*next++ = c;
+		}
+		void put(char const* text) {
+			while (*text)
+				put(*text++);
+		}
+	};
+
+
+	void write_fixed(text_writer& out, decimal_digits const& d, long long places) {
+		if (d.exponent < 0)
+			out.put('0');
+		for (long long i = 0; i <= d.exponent; ++i)
+			out.put(d[i]);
+		if (places > 0) {
+			out.put('.');
+			for (long long i = 1; i <= places; ++i)
+				out.put(d[d.exponent + i]);
+		}
+	}
+
+
+	void write_scientific(text_writer& out, decimal_digits const& d, long long places) {
+		out.put(d[0]);
+		if (places > 0) {
+			out.put('.');
+			for (long long i = 1; i <= places; ++i)
+				out.put(d[i]);
+		}
+		out.put('e');
+		out.put(d.exponent < 0 ? '-' : '+');
+		char text[16];
+		int const exponent = abs(d.exponent);
+		if (exponent < 10)
+			out.put('0');
+		*to_chars(text, text + sizeof(text) - 1, exponent).ptr = '\0';
+		out.put(text);
+	}
+}
+
+
+
+to_chars_result format_real(char* first, char* last, Real::value_type const& value, real_format_type format, unsigned digits) {
+	text_writer out(first, last);
+
+	if (boost::multiprecision::isnan(value))
+		out.put("nan");
+	else if (boost::multiprecision::isinf(value))
+		out.put(value < 0 ? "-inf" : "inf");
+	else {
+		bool const zero = value.is_zero();
+		if (!zero && value < 0)
+			out.put('-');
+		value_type const magnitude = abs(value);
+
+		// Zero is the single digit 0 at exponent 0 in every notation.
+		auto significant = [&](long long count) {
+			if (!zero)
+				return leading_digits(magnitude, count);
+			decimal_digits d;
+			d.digits[0] = '0';
+			d.count = 1;
+			return d;
+		};
+
+		switch (format) {
+		case FORMAT_FIXED:
+			write_fixed(out, significant(zero ? 1 : magnitude.backend().order() + 1LL + digits), digits);
+			break;
+		case FORMAT_SCIENTIFIC:
+			write_scientific(out, significant(1LL + digits), digits);
+			break;
+		default: {	// like printf's %g, but exact to the precision of value_type
+			long long const precision = digits == 0 ? numeric_limits<value_type>::digits10 : digits;
+			decimal_digits d = significant(precision);
+			while (d.count > 1 && d.digits[size_t(d.count - 1)] == '0')
+				--d.count;
+			if (d.exponent >= -5 && d.exponent < precision)
+				write_fixed(out, d, max(0LL, d.count - 1LL - d.exponent));
+			else
+				write_scientific(out, d, d.count - 1LL);
+		}
+		}
+	}
+
+	if (out.full)
+		return { last, errc::value_too_large };
+	return { out.next, errc() };
+}
+
+
+
+Real::string_type format_real(Real::value_type const& value, real_format_type format, unsigned digits) {
+	size_t size = 32 + size_t(digits);
+	if (format == FORMAT_FIXED && !value.is_zero())
+		size += size_t(max<long long>(0, value.backend().order()));
+	else if (format == FORMAT_GENERAL && digits == 0)
+		size += numeric_limits<value_type>::digits10;
+
+	Real::string_type text(size, '\0');
+	for (;;) {
+		auto result = format_real(text.data(), text.data() + text.size(), value, format, digits);
+		if (result.ec == errc()) {
+			text.resize(size_t(result.ptr - text.data()));
+			return text;
+		}
+		text.resize(text.size() * 2);
+	}
 }
 
 
@@ -33,6 +287,18 @@ Real::string_type Real::to_string() const {
 
 Revision History
 
+Version 1.4.0: 2026-10-18
+FORMAT_SHORTEST is FORMAT_GENERAL; added round_trip_digits() for the shortest round trip.
+
+Version 1.3.0: 2026-10-18
+Added format_real(); to_string() no longer uses iostreams.
+
+Version 1.2.0: 2026-10-18
+Added equals() and hash().
+
+Version 1.1.0: 2026-10-18
+Added digits_of() and precision_for_digits().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -12,6 +12,7 @@
 #include "operand.hpp"
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/math/constants/constants.hpp>
+#include <charconv>
 
 
 /*! Real number token. */
@@ -19,32 +20,121 @@ class Real : public Operand {
 public:
 	DEF_POINTER_TYPE(Real)
 	using value_type = boost::multiprecision::number<boost::multiprecision::cpp_dec_float<1000, int32_t, void>>;
+	static constexpr token_kind_type KIND = Operand::KIND | TK_REAL;
 private:
 	value_type	value_;
+protected:
+	Real(value_type const& value, token_kind_type kind) : Operand(kind | TK_REAL), value_(value) { }
 public:
-	Real(value_type value = value_type(0)) : value_(value) { }
+	Real(value_type value = value_type(0)) : Operand(TK_REAL), value_(value) { }
 	value_type				get_value() const { return value_; }
 	string_type				to_string() const;
+	bool					equals(Token const& other) const override;
+	std::size_t				hash() const override;
+};
+
+
+/*! Real output notations. */
+enum real_format_type {
+	FORMAT_FIXED,		// 'digits' places after the decimal point
+	FORMAT_SCIENTIFIC,	// d.ddd e+xx with 'digits' places after the decimal point
+	FORMAT_GENERAL		// at most 'digits' significant digits without trailing zeros, fixed or scientific by magnitude (printf's %g)
+};
+
+
+/*! Writes 'value' into [first, last) without iostreams.  Rounds half away from zero.
+	For FORMAT_GENERAL a 'digits' of 0 means the full precision of the value type.
+	Returns the end of the text, or {last, errc::value_too_large} if it does not fit (as std::to_chars). */
+std::to_chars_result format_real(char* first, char* last, Real::value_type const& value, real_format_type format, unsigned digits);
+
+/*! Formats 'value' as a string. */
+Real::string_type format_real(Real::value_type const& value, real_format_type format, unsigned digits);
+
+
+/*! Real number precision tiers.  Each tier has its own evaluation engine. */
+enum real_precision_type { PRECISION_DOUBLE, PRECISION_50, PRECISION_100, PRECISION_1000, PRECISION_COUNT };
+
+
+/*! Maps a precision tier to the value type its engine computes with. */
+template <real_precision_type PRECISION> struct real_tier;
+template <> struct real_tier<PRECISION_DOUBLE> { using value_type = double; };
+template <> struct real_tier<PRECISION_50> { using value_type = boost::multiprecision::cpp_dec_float_50; };
+template <> struct real_tier<PRECISION_100> { using value_type = boost::multiprecision::cpp_dec_float_100; };
+template <> struct real_tier<PRECISION_1000> { using value_type = Real::value_type; };
+
+
+/*! Gets the number of significant decimal digits of a precision tier. */
+unsigned digits_of(real_precision_type precision);
+
+/*! Gets the smallest precision tier giving at least 'digits' significant decimal digits. */
+real_precision_type precision_for_digits(unsigned digits);
+
+/*! Gets the fewest significant digits, from the digits of the tier up to its max_digits10, whose rounding of 'value'
+	reads back as the same value in the tier's type.  FORMAT_GENERAL with these digits is the shortest round trip. */
+unsigned round_trip_digits(Real::value_type const& value, real_precision_type precision);
+
+
+/*! Process-wide cache of real constants, keyed by precision (the value type).
+	Each constant is computed on first use only; initialization is thread-safe. */
+template <typename VALUE_TYPE>
+struct real_constants {
+	static VALUE_TYPE const& pi() {
+		static VALUE_TYPE const value = boost::math::constants::pi<VALUE_TYPE>();
+		return value;
+	}
+	static VALUE_TYPE const& e() {
+		static VALUE_TYPE const value = boost::math::constants::e<VALUE_TYPE>();
+		return value;
+	}
 };
 
 
 /*! Pi constant token. */
 class Pi : public Real {
 public:
-	Pi() : Real(boost::math::constants::pi<value_type>()) { }
+	static constexpr token_kind_type KIND = Real::KIND | TK_PI;
+	Pi() : Real(real_constants<value_type>::pi(), TK_PI) { }
+
+	/*! The shared Pi token. */
+	static Token::pointer_type const& instance() {
+		static Token::pointer_type const token = make<Pi>();
+		return token;
+	}
 };
 
 
 /*! Euler constant token. */
 class E : public Real {
 public:
-	E() : Real(boost::math::constants::e<value_type>()) { }
+	static constexpr token_kind_type KIND = Real::KIND | TK_E;
+	E() : Real(real_constants<value_type>::e(), TK_E) { }
+
+	/*! The shared E token. */
+	static Token::pointer_type const& instance() {
+		static Token::pointer_type const token = make<E>();
+		return token;
+	}
 };
 
 /*=============================================================
 
 Revision History
 
+Version 1.5.0: 2026-10-18
+Added format_real().
+
+Version 1.4.0: 2026-10-18
+Added token kinds.
+
+Version 1.3.0: 2026-10-18
+Added value equality and hashing.
+
+Version 1.2.0: 2026-10-18
+Added real_precision_type tiers.
+
+Version 1.1.0: 2026-10-18
+Added real_constants cache and shared Pi/E tokens.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -0,0 +1,180 @@
+/*! \file		result_history.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		ResultHistory class implementation.
+	*/
+
+#include "../inc/result_history.hpp"
+#include "../inc/boolean.hpp"
+#include "../inc/variable.hpp"
+#include <mutex>
+#include <string>
+using namespace std;
+
+namespace {
+	enum slot_kind_type { S_EMPTY, S_BOOLEAN, S_SMALL, S_BIG, S_REAL };
+
+	/*! The heap bytes of a big Integer's digits. */
+	size_t bytes_of(Integer::value_type const& value) {
+		return value.backend().size() * sizeof(boost::multiprecision::limb_type);
+	}
+}
+
+
+
+ResultHistory::ResultHistory(size_t capacity, size_t budget) : slots_(capacity), budget_(budget) { }
+
+
+
+/*! Empties the slot of result n, which must be kept. */
+void ResultHistory::forget(number_type n) {
+	value_type& slot = slots_[size_t(n % slots_.size())];
+	if (slot.index() == S_BIG) {
+		size_t const bytes = bytes_of(std::get<S_BIG>(slot));
+		large_.erase({ bytes, n });
+		bytes_ -= bytes;
+	}
+	slot.emplace<S_EMPTY>();
+}
+
+
+
+/*! Evicts the largest big Integers until the rest fit the budget. */
+void ResultHistory::trim() {
+	while (bytes_ > budget_)
+		forget(large_.begin()->second);
+}
+
+
+
+ResultHistory::number_type ResultHistory::record(Operand::pointer_type const& result) {
+	Operand::pointer_type value = result;
+	if (is<Variable>(value))
+		value = get_value<Variable>(value);
+
+	unique_lock<shared_mutex> lock(lock_);
+	number_type const n = ++last_;
+	if (slots_.empty())
+		return n;
+
+	if (n > slots_.size())
+		forget(n - slots_.size());
+
+	value_type& slot = slots_[size_t(n % slots_.size())];
+	if (is<Boolean>(value))
+		slot.emplace<S_BOOLEAN>(get_value<Boolean>(value));
+	else if (is<Integer>(value)) {
+		Integer const* i = static_cast<Integer const*>(value.get());
+		if (i->is_small())
+			slot.emplace<S_SMALL>(i->get_small());
+		else {
+			size_t const bytes = bytes_of(slot.emplace<S_BIG>(i->get_value()));
+			large_.insert({ bytes, n });
+			bytes_ += bytes;
+			trim();
+		}
+	}
+	else if (is<Real>(value))
+		slot.emplace<S_REAL>(get_value<Real>(value));
+	return n;
+}
+
+
+
+ResultHistory::value_type ResultHistory::get(Integer::small_type n) const {
+	shared_lock<shared_mutex> lock(lock_);
+	// -1 is the newest result; the magnitude is taken unsigned so the most negative n cannot overflow
+	number_type const number = n < 0 ? last_ + 1 - (number_type(0) - number_type(n)) : number_type(n);
+	if (n == 0 || number == 0 || number > last_ || last_ - number >= slots_.size())
+		throw exception(("Error: there is no result " + to_string(n)).c_str());
+
+	value_type const& slot = slots_[size_t(number % slots_.size())];
+	if (slot.index() == S_EMPTY)
+		throw exception(("Error: result " + to_string(n) + " is not available").c_str());
+	return slot;
+}
+
+
+
+ResultHistory::number_type ResultHistory::last() const {
+	shared_lock<shared_mutex> lock(lock_);
+	return last_;
+}
+
+
+
+void ResultHistory::set_capacity(size_t capacity) {
+	unique_lock<shared_mutex> lock(lock_);
+	number_type const kept = min<number_type>(last_, slots_.size());
+	number_type const first = last_ - min<number_type>(kept, capacity) + 1;
+	for (number_type n = last_ - kept + 1; n < first; ++n)
+		forget(n);
+
+	vector<value_type> slots(capacity);
+	for (number_type n = first; n <= last_; ++n)
+		slots[size_t(n % capacity)] = move(slots_[size_t(n % slots_.size())]);
+	slots_.swap(slots);
+}
+
+
+
+size_t ResultHistory::get_capacity() const {
+	shared_lock<shared_mutex> lock(lock_);
+	return slots_.size();
+}
+
+
+
+void ResultHistory::set_budget(size_t bytes) {
+	unique_lock<shared_mutex> lock(lock_);
+	budget_ = bytes;
+	trim();
+}
+
+
+
+size_t ResultHistory::get_budget() const {
+	shared_lock<shared_mutex> lock(lock_);
+	return budget_;
+}
+
+
+
+size_t ResultHistory::get_bytes() const {
+	shared_lock<shared_mutex> lock(lock_);
+	return bytes_;
+}
+
+
+
+void ResultHistory::clear() {
+	unique_lock<shared_mutex> lock(lock_);
+	for (value_type& slot : slots_)
+		slot.emplace<S_EMPTY>();
+	large_.clear();
+	bytes_ = 0;
+	last_ = 0;
+}
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -0,0 +1,100 @@
+#pragma once
+
+/*! \file		result_history.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		ResultHistory class declaration.
+	*/
+
+#include "operand.hpp"
+#include "integer.hpp"
+#include "real.hpp"
+#include <cstddef>
+#include <set>
+#include <shared_mutex>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/*! The results of an ExpressionEvaluator, numbered from 1 in the order they were recorded.
+	The values are kept unboxed in a ring of slots allocated up front, so result n is in slot n % capacity
+	and reading it is an indexed load.  Only the newest 'capacity' results are kept.
+	Big Integers are the only values whose size varies; past the memory budget, the largest are evicted first.
+	Thread-safe: readers share a lock that record() takes exclusively.
+	*/
+class ResultHistory {
+public:
+	typedef unsigned long long	number_type;
+	typedef std::variant<std::monostate, bool, Integer::small_type, Integer::value_type, Real::value_type>	value_type;
+
+	static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+	static constexpr std::size_t DEFAULT_BUDGET = std::size_t( 64 ) << 20;
+private:
+	typedef std::pair<std::size_t, number_type>	large_entry_type;	// the bytes and number of a big Integer
+
+	/*! Orders the big Integers in eviction order: the largest first, and the oldest of equal sizes. */
+	struct eviction_order {
+		bool operator () ( large_entry_type const& lhs, large_entry_type const& rhs ) const {
+			return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+		}
+	};
+
+	std::vector<value_type>							slots_;		// result n is in slot n % capacity; empty if evicted or not a value
+	number_type										last_ = 0;	// the newest result's number; 0 before the first
+	std::set<large_entry_type, eviction_order>		large_;		// the big Integers kept
+	std::size_t										bytes_ = 0;	// total bytes of large_
+	std::size_t										budget_;
+	mutable std::shared_mutex						lock_;
+
+	void	forget( number_type n );
+	void	trim();
+public:
+	explicit ResultHistory( std::size_t capacity = DEFAULT_CAPACITY, std::size_t budget = DEFAULT_BUDGET );
+
+	/*! Records a result, unboxed; a Variable is recorded by its value.
+		@return the result's number. */
+	number_type	record( Operand::pointer_type const& result );
+
+	/*! Gets result n.  Negative numbers count back from the newest: -1 is the newest result.
+		@note Throws if result n was never recorded, is no longer kept, or is not a value. */
+	value_type	get( Integer::small_type n ) const;
+
+	/*! Gets the number of the newest result, 0 if there is none. */
+	number_type	last() const;
+
+	/*! Sets the number of results kept, keeping the newest.  0 keeps none, but results are still numbered. */
+	void		set_capacity( std::size_t capacity );
+	std::size_t	get_capacity() const;
+
+	/*! Sets the bytes of big Integer digits kept, evicting the largest results until they fit. */
+	void		set_budget( std::size_t bytes );
+	std::size_t	get_budget() const;
+	std::size_t	get_bytes() const;
+
+	/*! Forgets every result; numbering starts again from 1. */
+	void		clear();
+};
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
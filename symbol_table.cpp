@@ -0,0 +1,97 @@
+/*! \file		symbol_table.cpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		SymbolTable class implementation.
+	*/
+
+#include "../inc/symbol_table.hpp"
+using namespace std;
+
+SymbolTable::SymbolTable() : buckets_(16, EMPTY) { }
+
+
+
+/*! FNV-1a. */
+size_t SymbolTable::hash(string_view text) {
+	uint64_t h = 14695981039346656037ull;
+	for (unsigned char c : text) {
+		h ^= c;
+		h *= 1099511628211ull;
+	}
+	return size_t(h);
+}
+
+
+
+/*! Finds the bucket holding 'text', or the empty bucket where it would go. */
+size_t SymbolTable::probe(string_view text, size_t hash) const {
+	size_t const mask = buckets_.size() - 1;
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		bucket_type slot = buckets_[i];
+		if (slot == EMPTY || (hashes_[slot] == hash && names_[slot] == text))
+			return i;
+	}
+}
+
+
+
+void SymbolTable::grow() {
+	vector<bucket_type> buckets(buckets_.size() * 2, EMPTY);
+	size_t const mask = buckets.size() - 1;
+	for (size_t slot = 0; slot < names_.size(); ++slot) {
+		size_t i = hashes_[slot] & mask;
+		while (buckets[i] != EMPTY)
+			i = (i + 1) & mask;
+		buckets[i] = bucket_type(slot);
+	}
+	buckets_.swap(buckets);
+}
+
+
+
+SymbolTable::slot_type SymbolTable::intern(string_view text) {
+	size_t const h = hash(text);
+	size_t i = probe(text, h);
+	if (buckets_[i] != EMPTY)
+		return buckets_[i];
+
+	if ((names_.size() + 1) * 2 > buckets_.size()) {
+		grow();
+		i = probe(text, h);
+	}
+	slot_type slot = names_.size();
+	names_.emplace_back(text);
+	hashes_.push_back(h);
+	buckets_[i] = bucket_type(slot);
+	return slot;
+}
+
+
+
+SymbolTable::slot_type SymbolTable::find(string_view text) const {
+	bucket_type slot = buckets_[probe(text, hash(text))];
+	return slot == EMPTY ? NO_SLOT : slot;
+}
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
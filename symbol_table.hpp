@@ -0,0 +1,69 @@
+#pragma once
+
+/*! \file		symbol_table.hpp
+	\author		Garth Santor/Trinh Han
+	\date		2026-10-18
+	\version	1.0.0
+	\note		Compiles under Visual C++ v142 (std:c++ 17)
+
+	\brief		SymbolTable class declaration.
+	*/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/*! Interns identifiers, giving each distinct text a dense slot: 0, 1, 2, ... in order of first appearance.
+	Lookups probe an open-addressed hash table of slots; the names and their hashes are kept in slot order.
+	*/
+class SymbolTable {
+public:
+	typedef std::size_t		slot_type;
+	typedef std::string		string_type;
+	static constexpr slot_type NO_SLOT = slot_type(-1);
+private:
+	typedef std::uint32_t	bucket_type;
+	static constexpr bucket_type EMPTY = bucket_type(-1);
+
+	std::vector<bucket_type>	buckets_;	// slots; the size is a power of two, at most half full
+	std::vector<string_type>	names_;		// by slot
+	std::vector<std::size_t>	hashes_;	// by slot
+
+	static std::size_t	hash( std::string_view text );
+	std::size_t			probe( std::string_view text, std::size_t hash ) const;
+	void				grow();
+public:
+	SymbolTable();
+
+	/*! Gets the slot of an identifier, giving it the next slot if it is new. */
+	slot_type			intern( std::string_view text );
+
+	/*! Gets the slot of an identifier, or NO_SLOT if it has not been interned. */
+	slot_type			find( std::string_view text ) const;
+
+	string_type const&	name( slot_type slot ) const { return names_[slot]; }
+	std::size_t			size() const { return names_.size(); }
+	bool				empty() const { return names_.empty(); }
+};
+
+/*=============================================================
+
+Revision History
+
+Version 1.0.0: 2026-10-18
+Initial version.
+
+=============================================================
+
+Copyright Garth Santor/Trinh Han
+
+The copyright to the computer program(s) herein
+is the property of Garth Santor/Trinh Han of Canada.
+The program(s) may be used and/or copied only with
+the written permission of Garth Santor/Trinh Han
+or in accordance with the terms and conditions
+stipulated in the agreement/contract under which
+the program(s) have been supplied.
+=============================================================*/
@@ -16,10 +16,23 @@ Token::string_type	Token::to_string() const {
 }
 
 
+bool Token::equals(Token const& other) const {
+	return typeid(*this) == typeid(other);
+}
+
+
+std::size_t Token::hash() const {
+	return typeid(*this).hash_code();
+}
+
+
 /*=============================================================
 
 Revision History
 
+Version 1.1.0: 2026-10-18
+Added equals() and hash().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
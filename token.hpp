@@ -8,9 +8,12 @@
 	\brief		Token class declaration for Expression Evaluator project.
 	*/
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <string>
+#include <type_traits>
 #include <typeinfo>
 #include <vector>
 #include <ostream>
@@ -21,19 +24,75 @@
 #define DEF_POINTER_TYPE(_TT) using pointer_type = std::shared_ptr<_TT>;
 
 
+/*! Token family flags.  A token carries the flag of every family it belongs to, set once at construction,
+	so family membership is a mask test instead of a dynamic_cast. */
+using token_kind_type = std::uint32_t;
+enum token_kind_flag_type : token_kind_type {
+	TK_NONE					= 0,
+	// operands
+	TK_OPERAND				= 1u << 0,
+	TK_BOOLEAN				= 1u << 1,
+	TK_TRUE					= 1u << 2,
+	TK_FALSE				= 1u << 3,
+	TK_INTEGER				= 1u << 4,
+	TK_REAL					= 1u << 5,
+	TK_PI					= 1u << 6,
+	TK_E					= 1u << 7,
+	TK_VARIABLE				= 1u << 8,
+	// operations
+	TK_OPERATION			= 1u << 9,
+	TK_OPERATOR				= 1u << 10,
+	TK_BINARY_OPERATOR		= 1u << 11,
+	TK_RASSOC_OPERATOR		= 1u << 12,
+	TK_LASSOC_OPERATOR		= 1u << 13,
+	TK_NON_ASSOCIATIVE		= 1u << 14,
+	TK_UNARY_OPERATOR		= 1u << 15,
+	TK_POSTFIX_OPERATOR		= 1u << 16,
+	TK_FUNCTION				= 1u << 17,
+	TK_ONE_ARG_FUNCTION		= 1u << 18,
+	TK_TWO_ARG_FUNCTION		= 1u << 19,
+	// pseudo-operations
+	TK_PSEUDO_OPERATION		= 1u << 20,
+	TK_PARENTHESIS			= 1u << 21,
+	TK_LEFT_PARENTHESIS		= 1u << 22,
+	TK_RIGHT_PARENTHESIS	= 1u << 23,
+	TK_ARGUMENT_SEPARATOR	= 1u << 24
+};
+
+
+/*! Defines a token family: its KIND mask and the constructors that accumulate the family flag.
+	Used inside the class declaration of every token class that is not an operation leaf. */
+#define DEF_TOKEN_KIND(_CLASS, _BASE, _FLAG) \
+	public: static constexpr token_kind_type KIND = _BASE::KIND | (_FLAG); \
+	protected: explicit _CLASS(token_kind_type kind) : _BASE(kind | (_FLAG)) { } \
+	public: _CLASS() : _BASE(token_kind_type(_FLAG)) { }
+
+
 /*! Token base class. */
 class Token {
 public:
 	DEF_POINTER_TYPE(Token)
 	using string_type = std::string;
-	
+	static constexpr token_kind_type KIND = TK_NONE;
+private:
+	token_kind_type	kind_;
+protected:
+	explicit Token(token_kind_type kind) : kind_(kind) { }
+public:
 	// Block copying
 	Token(Token const&) = delete;
 	Token& operator = (Token const&) = delete;
 
-	Token() = default;
+	Token() : kind_(TK_NONE) { }
 	virtual ~Token() = default;
+	token_kind_type		get_kind() const { return kind_; }
 	virtual string_type	to_string() const;
+
+	/*! Value equality.  By default tokens of the same class are equal; operands compare their values. */
+	virtual bool		equals(Token const& other) const;
+
+	/*! Hash consistent with equals(). */
+	virtual std::size_t	hash() const;
 };
 
 
@@ -43,6 +102,15 @@ template <typename T> inline Token::pointer_type make() { return Token::pointer_
 
 
 
+/*! Gets the shared instance of a stateless token class, created on first use.
+	Tokens are immutable, so one instance can stand for every occurrence. */
+template <typename T> inline Token::pointer_type const& flyweight() {
+	static Token::pointer_type const instance = make<T>();
+	return instance;
+}
+
+
+
 /*! Make a new smart-pointer managed Token object with constructor parameter. */
 template <typename T, typename U> inline Token::pointer_type make(U const& param) { return Token::pointer_type(new T(param)); }
 
@@ -50,11 +118,41 @@ template <typename T, typename U> inline Token::pointer_type make(U const& param
 
 /*! Compare two tokens for same value. */
 inline bool operator == (Token::pointer_type const& lhs, Token::pointer_type const& rhs) {
-#if !defined(NDEBUG)
-	auto l = lhs->to_string();
-	auto r = rhs->to_string();
-#endif
-	return lhs->to_string() == rhs->to_string();
+	return lhs.get() == rhs.get() || lhs->equals(*rhs);
+}
+
+inline bool operator != (Token::pointer_type const& lhs, Token::pointer_type const& rhs) {
+	return !(lhs == rhs);
+}
+
+
+
+/*! Function objects for unordered containers keyed by token value. */
+struct TokenHash {
+	std::size_t operator () (Token::pointer_type const& tkn) const { return tkn->hash(); }
+};
+
+struct TokenEqual {
+	bool operator () (Token::pointer_type const& lhs, Token::pointer_type const& rhs) const { return lhs == rhs; }
+};
+
+
+
+/*! Operation leaf classes share their family's KIND and are told apart by OPERATION_ID. */
+template <typename T, typename = void> struct is_operation_leaf : std::false_type { };
+template <typename T> struct is_operation_leaf<T, std::void_t<decltype(T::OPERATION_ID)>> : std::true_type { };
+
+
+
+/*! Test for family membership. */
+template <typename CAST_TYPE>
+inline bool is_kind(Token const* tknPtr) {
+	if (!tknPtr || (tknPtr->get_kind() & CAST_TYPE::KIND) != CAST_TYPE::KIND)
+		return false;
+	if constexpr (is_operation_leaf<CAST_TYPE>::value)
+		return static_cast<typename CAST_TYPE::operation_type const*>(tknPtr)->get_operation_id() == CAST_TYPE::OPERATION_ID;
+	else
+		return true;
 }
 
 
@@ -62,7 +160,7 @@ inline bool operator == (Token::pointer_type const& lhs, Token::pointer_type con
 /*! Test for family membership. */
 template <typename CAST_TYPE, typename ORIGINAL_TYPE>
 inline bool is(ORIGINAL_TYPE const& tkn) {
-	return dynamic_cast<CAST_TYPE const*>(tkn.get()) != nullptr;
+	return is_kind<CAST_TYPE>(tkn.get());
 }
 
 
@@ -70,7 +168,7 @@ inline bool is(ORIGINAL_TYPE const& tkn) {
 /*! Test for family membership. */
 template <typename CAST_TYPE, typename ORIGINAL_TYPE>
 inline bool is(ORIGINAL_TYPE const * tknPtr) {
-	return dynamic_cast<CAST_TYPE const*>(tknPtr) != nullptr;
+	return is_kind<CAST_TYPE>(tknPtr);
 }
 
 
@@ -78,7 +176,9 @@ inline bool is(ORIGINAL_TYPE const * tknPtr) {
 /*! Convert to subclass type. */
 template <typename CONVERTED_TYPE>
 inline typename CONVERTED_TYPE::pointer_type convert(Token::pointer_type const& tkn) {
-	return std::dynamic_pointer_cast<CONVERTED_TYPE>(tkn);
+	if (!is_kind<CONVERTED_TYPE>(tkn.get()))
+		return nullptr;
+	return std::static_pointer_cast<CONVERTED_TYPE>(tkn);
 }
 
 
@@ -102,6 +202,15 @@ inline std::ostream& operator << (std::ostream& os, Token::pointer_type const& t
 
 Revision History
 
+Version 1.3.0: 2026-10-18
+is<>() and convert<>() test a token kind mask set at construction instead of using dynamic_cast.
+
+Version 1.2.0: 2026-10-18
+Token equality and hashing are virtual and value based instead of comparing to_string().
+
+Version 1.1.0: 2026-10-18
+Added flyweight<T>().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -17,6 +17,7 @@
 #include "../inc/real.hpp"
 #include "../inc/variable.hpp"
 
+#include <cstdint>
 #include <exception>
 #include <limits>
 #include <sstream>
@@ -24,198 +25,303 @@
 #include <string>
 using namespace std;
 
-/** Default constructor loads the keyword dictionary. */
-Tokenizer::Tokenizer() {
-	keywords_["abs"]     = keywords_["Abs"]		= keywords_["ABS"]		= make<Abs>();
-	keywords_["and"]     = keywords_["And"]		= keywords_["AND"]		= make<And>();
-	keywords_["arccos"]  = keywords_["Arccos"]	= keywords_["ARCCOS"]	= make<Arccos>();
-	keywords_["arcsin"]  = keywords_["Arcsin"]	= keywords_["ARCSIN"]	= make<Arcsin>();
-	keywords_["arctan"]  = keywords_["Arctan"]	= keywords_["ARCTAN"]	= make<Arctan>();
-	keywords_["arctan2"] = keywords_["Arctan2"]	= keywords_["ARCTAN2"]	= make<Arctan2>();
-	keywords_["ceil"]    = keywords_["Ceil"]	= keywords_["CEIL"]		= make<Ceil>();
-	keywords_["cos"]     = keywords_["Cos"]		= keywords_["COS"]		= make<Cos>();
-	keywords_["e"]       = keywords_["E"]								= make<E>();
-	keywords_["exp"]     = keywords_["Exp"]		= keywords_["EXP"]		= make<Exp>();
-	keywords_["false"]   = keywords_["False"]	= keywords_["FALSE"]	= make<False>();
-	keywords_["floor"]   = keywords_["Floor"]	= keywords_["FLOOR"]	= make<Floor>();
-	keywords_["lb"]      = keywords_["Lb"]		= keywords_["LB"]		= make<Lb>();
-	keywords_["ln"]      = keywords_["Ln"]		= keywords_["LN"]		= make<Ln>();
-	keywords_["log"]     = keywords_["Log"]		= keywords_["LOG"]		= make<Log>();
-	keywords_["max"]     = keywords_["Max"]		= keywords_["MAX"]		= make<Max>();
-	keywords_["min"]     = keywords_["Min"]		= keywords_["MIN"]		= make<Min>();
-	keywords_["mod"]     = keywords_["Mod"]		= keywords_["MOD"]		= make<Modulus>();
-	keywords_["nand"]    = keywords_["Nand"]	= keywords_["NAND"]		= make<Nand>();
-	keywords_["nor"]     = keywords_["Nor"]		= keywords_["NOR"]		= make<Nor>();
-	keywords_["not"]     = keywords_["Not"]		= keywords_["NOT"]		= make<Not>();
-	keywords_["or"]      = keywords_["Or"]		= keywords_["OR"]		= make<Or>();
-	keywords_["pi"]      = keywords_["Pi"]		= keywords_["PI"]		= make<Pi>();
-	keywords_["pow"]     = keywords_["Pow"]		= keywords_["POW"]		= make<Pow>();
-	keywords_["result"]  = keywords_["Result"]	= keywords_["RESULT"]	= make<Result>();
-	keywords_["sin"]     = keywords_["Sin"]		= keywords_["SIN"]		= make<Sin>();
-	keywords_["sqrt"]    = keywords_["Sqrt"]	= keywords_["SQRT"]		= make<Sqrt>();
-	keywords_["tan"]     = keywords_["Tan"]		= keywords_["TAN"]		= make<Tan>();
-	keywords_["true"]    = keywords_["True"]	= keywords_["TRUE"]		= make<True>();
-	keywords_["xnor"]    = keywords_["Xnor"]	= keywords_["XNOR"]		= make<Xnor>();
-	keywords_["xor"]     = keywords_["Xor"]		= keywords_["XOR"]		= make<Xor>();
-}
-
-
+namespace {
+	/*! The keywords, matched case-insensitively.  keyword_tokens() lists their tokens in the same order. */
+	constexpr char const* keywordNames[] = {
+		"abs", "and", "arccos", "arcsin", "arctan", "arctan2", "ceil", "cos", "e", "exp",
+		"false", "floor", "lb", "ln", "log", "max", "min", "mod", "nand", "nor",
+		"not", "or", "pi", "pow", "result", "sin", "sqrt", "tan", "true", "xnor",
+		"xor"
+	};
+	constexpr size_t KEYWORD_COUNT = sizeof(keywordNames) / sizeof(keywordNames[0]);
+
+	Token::pointer_type const* keyword_tokens() {
+		static Token::pointer_type const tokens[KEYWORD_COUNT] = {
+			flyweight<Abs>(), flyweight<And>(), flyweight<Arccos>(), flyweight<Arcsin>(), flyweight<Arctan>(), flyweight<Arctan2>(), flyweight<Ceil>(), flyweight<Cos>(), E::instance(), flyweight<Exp>(),
+			flyweight<False>(), flyweight<Floor>(), flyweight<Lb>(), flyweight<Ln>(), flyweight<Log>(), flyweight<Max>(), flyweight<Min>(), flyweight<Modulus>(), flyweight<Nand>(), flyweight<Nor>(),
+			flyweight<Not>(), flyweight<Or>(), Pi::instance(), flyweight<Pow>(), flyweight<Result>(), flyweight<Sin>(), flyweight<Sqrt>(), flyweight<Tan>(), flyweight<True>(), flyweight<Xnor>(),
+			flyweight<Xor>()
+		};
+		return tokens;
+	}
 
 
-/** Get an identifier from the expression.
-	Assumes that the currentChar is pointing to a alphabetic.
-	*/
-Token::pointer_type Tokenizer::_get_identifier(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression) {
-	// accumulate identifier
-	string_type ident;
-	do
-		ident += *currentChar++;
-	while (currentChar != end(expression) && isalnum(*currentChar));
-
-	// check for predefined identifier
-	dictionary_type::iterator iter = keywords_.find(ident);
-	if (iter != end(keywords_))
-		return iter->second;
-
-	// check for variable
-	iter = variables_.find(ident);
-	if (iter != variables_.end())
-		return iter->second;
-
-	// add a variable
-	Token::pointer_type result = make<Variable>();
-	variables_[ident] = result;
-	return result;
-}
 
+	// Perfect hash of the keywords: case-folded FNV-1a, top bits.  The seed was searched for offline.
+	constexpr unsigned			KEYWORD_HASH_BITS = 6;
+	constexpr size_t			KEYWORD_SLOTS = size_t(1) << KEYWORD_HASH_BITS;
+	constexpr std::uint32_t		KEYWORD_HASH_SEED = 3373;
 
+	constexpr char fold_case(char ch) { return ch >= 'A' && ch <= 'Z' ? char(ch - 'A' + 'a') : ch; }
 
+	constexpr size_t keyword_hash(char const* first, size_t length) {
+		std::uint32_t hash = KEYWORD_HASH_SEED;
+		for (size_t i = 0; i < length; ++i)
+			hash = (hash ^ std::uint32_t(fold_case(first[i]))) * 16777619u;
+		return hash >> (32 - KEYWORD_HASH_BITS);
+	}
 
-/** Get a number token from the expression.
-	@return One of BinaryInteger, Integer, or Real.
-	@param currentChar [in,out] an iterator to the current character.  Assumes that the currentChar is pointing to a digit.
-	@param expression [in] the expression being scanned.
-*/
-Token::pointer_type Tokenizer::_get_number(Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression) {
-	assert(isdigit(*currentChar) && "currentChar must pointer to a digit");
+	constexpr size_t length_of(char const* s) {
+		size_t n = 0;
+		while (s[n]) ++n;
+		return n;
+	}
 
-	// Either Integer or Real
-	string digits(1, *currentChar++);
+	/*! Maps a hash slot to its keyword's index, or -1. */
+	struct keyword_slot_table {
+		signed char	keyword[KEYWORD_SLOTS];
+		bool		perfect;
+	};
+
+	constexpr keyword_slot_table make_keyword_slots() {
+		keyword_slot_table table{};
+		table.perfect = true;
+		for (size_t s = 0; s < KEYWORD_SLOTS; ++s)
+			table.keyword[s] = -1;
+		for (size_t k = 0; k < KEYWORD_COUNT; ++k) {
+			size_t s = keyword_hash(keywordNames[k], length_of(keywordNames[k]));
+			if (table.keyword[s] != -1)
+				table.perfect = false;
+			table.keyword[s] = static_cast<signed char>(k);
+		}
+		return table;
+	}
 
-	while (currentChar != end(expression) && isdigit(*currentChar))
-		digits += *currentChar++;
+	constexpr keyword_slot_table keywordSlots = make_keyword_slots();
+	static_assert(keywordSlots.perfect, "keyword hash collision: search for a new KEYWORD_HASH_SEED");
 
-	if (currentChar == end(expression) || (!isdigit(*currentChar) && *currentChar != '.'))
-		return make<Integer>(Integer::value_type(digits));
 
-	// a real number
-	digits += *currentChar++;
-	while (currentChar != end(expression) && isdigit(*currentChar))
-		digits += *currentChar++;
 
+	/*! Finds a keyword with a single probe.
+		@return the keyword's index, or -1 if 'ident' is not a keyword. */
+	int find_keyword(std::string_view ident) {
+		int k = keywordSlots.keyword[keyword_hash(ident.data(), ident.size())];
+		if (k < 0)
+			return -1;
 
-	return make<Real>(Real::value_type(digits));
+		char const* name = keywordNames[k];
+		for (char ch : ident)
+			if (*name++ != fold_case(ch))
+				return -1;
+		if (*name != '\0')
+			return -1;
+		return k;
+	}
 }
 
 
 
-/** Tokenize the expression.
-	@return a TokenList containing the tokens from 'expression'.
-	@param expression [in] The expression to tokenize.
-	@note Tokenizer dictionary may be updated if expression contains variables.
-	@note Will throws 'BadCharacter' if the expression contains an un-tokenizable character.
+
+/** Scan the expression into lexemes.
+	@return the lexemes of 'expression', in order.
+	@param expression [in] The expression to scan.
+	@note Will throw 'XBadCharacter' if the expression contains an un-tokenizable character.
 	*/
-TokenList Tokenizer::tokenize(string_type const& expression) {
-	TokenList tokenizedExpression;
-	auto currentChar = expression.cbegin();
+LexemeList Tokenizer::scan(std::string_view expression) const {
+	LexemeList lexemes;
+	char const* const first = expression.data();
+	char const* const last = first + expression.size();
+	char const* currentChar = first;
+
+	auto emit = [&](lexeme_kind_type kind, char const* start, unsigned keyword = 0) {
+		lexemes.push_back(Lexeme{ kind, static_cast<unsigned char>(keyword), std::uint32_t(start - first), std::uint32_t(currentChar - start) });
+	};
+
+	// '+' and '-' are binary after something that ends an operand
+	auto follows_operand = [&]() {
+		if (lexemes.empty())
+			return false;
+		switch (lexemes.back().kind) {
+		case LEX_INTEGER: case LEX_REAL: case LEX_VARIABLE: case LEX_RIGHT_PARENTHESIS: case LEX_FACTORIAL:
+			return true;
+		case LEX_KEYWORD:
+			return is<Operand>(keyword_tokens()[lexemes.back().keyword]);
+		default:
+			return false;
+		}
+	};
 
 	for(;;)
 	{
 		// strip whitespace
-		while (currentChar != end(expression) && isspace(*currentChar))
+		while (currentChar != last && isspace(*currentChar))
 			++currentChar;
 
 		// check of end of expression
-		if (currentChar == end(expression)) break;
+		if (currentChar == last) break;
+
+		char const* start = currentChar;
 
-		// check for a number
+		// check for a number: digits, and a Real if followed by a '.'
 		if (isdigit(*currentChar)) {
-			tokenizedExpression.push_back(_get_number(currentChar, expression));
+			while (currentChar != last && isdigit(*currentChar))
+				++currentChar;
+			if (currentChar == last || *currentChar != '.') {
+				emit(LEX_INTEGER, start);
+				continue;
+			}
+			++currentChar;
+			while (currentChar != last && isdigit(*currentChar))
+				++currentChar;
+			emit(LEX_REAL, start);
 			continue;
 		}
 
 		// check for 2-character operators
-#define CHECK_2OP( symbol1, symbol2, token )\
-		if( *currentChar == symbol1 ) {\
-			auto nextChar = next(currentChar);\
-			if( nextChar != end(expression) && *nextChar == symbol2 ) {\
-				currentChar = next(nextChar);\
-				tokenizedExpression.push_back( make<token>() );\
-				continue;\
-			}\
+#define CHECK_2OP( symbol1, symbol2, kind )\
+		if( *currentChar == symbol1 && next(currentChar) != last && *next(currentChar) == symbol2 ) {\
+			currentChar += 2;\
+			emit( kind, start );\
+			continue;\
 		}
-		CHECK_2OP('<', '=', LessEqual)
-		CHECK_2OP('>', '=', GreaterEqual)
-		CHECK_2OP('=', '=', Equality)
-		CHECK_2OP('!', '=', Inequality)
-		CHECK_2OP('*', '*', Power)
+		CHECK_2OP('<', '=', LEX_LESS_EQUAL)
+		CHECK_2OP('>', '=', LEX_GREATER_EQUAL)
+		CHECK_2OP('=', '=', LEX_EQUALITY)
+		CHECK_2OP('!', '=', LEX_INEQUALITY)
+		CHECK_2OP('*', '*', LEX_POWER)
 #undef CHECK_2OP
 
 			// check for 1-character operators
-#define CHECK_OP(symbol, token)\
+#define CHECK_OP(symbol, kind)\
 		if( *currentChar == symbol ) {\
 			++currentChar;\
-			tokenizedExpression.push_back( make<token>() );\
+			emit( kind, start );\
 			continue;\
 		}
-		CHECK_OP('*', Multiplication)
-		CHECK_OP('/', Division)
-		CHECK_OP('%', Modulus)
-		CHECK_OP('(', LeftParenthesis)
-		CHECK_OP(')', RightParenthesis)
-		CHECK_OP(',', ArgumentSeparator)
-		CHECK_OP('<', Less)
-		CHECK_OP('>', Greater)
-		CHECK_OP('!', Factorial)
-		CHECK_OP('=', Assignment)
+		CHECK_OP('*', LEX_MULTIPLICATION)
+		CHECK_OP('/', LEX_DIVISION)
+		CHECK_OP('%', LEX_MODULUS)
+		CHECK_OP('(', LEX_LEFT_PARENTHESIS)
+		CHECK_OP(')', LEX_RIGHT_PARENTHESIS)
+		CHECK_OP(',', LEX_ARGUMENT_SEPARATOR)
+		CHECK_OP('<', LEX_LESS)
+		CHECK_OP('>', LEX_GREATER)
+		CHECK_OP('!', LEX_FACTORIAL)
+		CHECK_OP('=', LEX_ASSIGNMENT)
 #undef CHECK_OP
 
 
 		// check for multi-purpose operators
 		if (*currentChar == '+') {
+			bool binary = follows_operand();
 			++currentChar;
-			if (!tokenizedExpression.empty() &&
-				(is<RightParenthesis>(tokenizedExpression.back()) ||
-					is<Operand>(tokenizedExpression.back()) ||
-					is<PostfixOperator>(tokenizedExpression.back())))
-				tokenizedExpression.push_back(make<Addition>());
-			else
-				tokenizedExpression.push_back(make<Identity>());
+			emit(binary ? LEX_ADDITION : LEX_IDENTITY, start);
 			continue;
 		}
 		if (*currentChar == '-') {
+			bool binary = follows_operand();
 			++currentChar;
-			if (!tokenizedExpression.empty() &&
-				(is<RightParenthesis>(tokenizedExpression.back()) ||
-					is<Operand>(tokenizedExpression.back()) ||
-					is<PostfixOperator>(tokenizedExpression.back())))
-				tokenizedExpression.push_back(make<Subtraction>());
-			else
-				tokenizedExpression.push_back(make<Negation>());
+			emit(binary ? LEX_SUBTRACTION : LEX_NEGATION, start);
 			continue;
 		}
 
 
-		// Identifiers
+		// Identifiers: keywords or variables
 		if (isalpha(*currentChar)) {
-			tokenizedExpression.push_back(_get_identifier(currentChar, expression));
+			do
+				++currentChar;
+			while (currentChar != last && isalnum(*currentChar));
+
+			int keyword = find_keyword(std::string_view(start, currentChar - start));
+			if (keyword >= 0)
+				emit(LEX_KEYWORD, start, unsigned(keyword));
+			else
+				emit(LEX_VARIABLE, start);
 			continue;
 		}
 
 		// not a recognized token
-		throw XBadCharacter(expression, currentChar - begin(expression));
+		throw XBadCharacter(string_type(expression), currentChar - first);
 	}
 
+	return lexemes;
+}
+
+
+
+/** Build the token of a lexeme.
+	@return the lexeme's Token.
+	@param expression [in] The expression the lexeme was scanned from.
+	@param lexeme [in] The lexeme.
+	@note Tokenizer dictionary is updated if the lexeme is a new variable.
+	*/
+Token::pointer_type Tokenizer::materialize(std::string_view expression, Lexeme const& lexeme) {
+	std::string_view text = expression.substr(lexeme.offset, lexeme.length);
+
+	switch (lexeme.kind) {
+	case LEX_INTEGER:
+		if (text.size() <= size_t(numeric_limits<Integer::small_type>::digits10)) {
+			Integer::small_type value = 0;
+			for (char digit : text)
+				value = value * 10 + (digit - '0');
+			return make_integer(value);
+		}
+		return make<Integer>(from_decimal(text));
+	case LEX_REAL:					return make<Real>(Real::value_type(string_type(text)));
+	case LEX_KEYWORD:				return keyword_tokens()[lexeme.keyword];
+	case LEX_VARIABLE: {
+		SymbolTable::slot_type slot = symbols_.intern(text);
+		if (slot == variables_.size())
+			variables_.push_back(make<Variable>(Variable::slot_type(slot)));
+		return variables_[slot];
+	}
+	case LEX_ADDITION:				return flyweight<Addition>();
+	case LEX_IDENTITY:				return flyweight<Identity>();
+	case LEX_SUBTRACTION:			return flyweight<Subtraction>();
+	case LEX_NEGATION:				return flyweight<Negation>();
+	case LEX_MULTIPLICATION:		return flyweight<Multiplication>();
+	case LEX_DIVISION:				return flyweight<Division>();
+	case LEX_MODULUS:				return flyweight<Modulus>();
+	case LEX_POWER:					return flyweight<Power>();
+	case LEX_FACTORIAL:				return flyweight<Factorial>();
+	case LEX_LESS:					return flyweight<Less>();
+	case LEX_LESS_EQUAL:			return flyweight<LessEqual>();
+	case LEX_GREATER:				return flyweight<Greater>();
+	case LEX_GREATER_EQUAL:			return flyweight<GreaterEqual>();
+	case LEX_EQUALITY:				return flyweight<Equality>();
+	case LEX_INEQUALITY:			return flyweight<Inequality>();
+	case LEX_ASSIGNMENT:			return flyweight<Assignment>();
+	case LEX_LEFT_PARENTHESIS:		return flyweight<LeftParenthesis>();
+	case LEX_RIGHT_PARENTHESIS:		return flyweight<RightParenthesis>();
+	case LEX_ARGUMENT_SEPARATOR:	return flyweight<ArgumentSeparator>();
+	}
+	assert(!"unknown lexeme kind");
+	return Token::pointer_type();
+}
+
+
+
+Tokenizer::string_type Tokenizer::normalize(std::string_view expression) const {
+	LexemeList lexemes = scan(expression);
+
+	string_type text;
+	text.reserve(expression.size());
+	for (Lexeme const& lexeme : lexemes) {
+		if (!text.empty())
+			text += ' ';
+		if (lexeme.kind == LEX_KEYWORD)
+			text += keywordNames[lexeme.keyword];
+		else
+			text.append(expression.data() + lexeme.offset, lexeme.length);
+	}
+	return text;
+}
+
+
+
+/** Tokenize the expression.
+	@return a TokenList containing the tokens from 'expression'.
+	@param expression [in] The expression to tokenize.
+	@note Tokenizer dictionary may be updated if expression contains variables.
+	@note Will throws 'BadCharacter' if the expression contains an un-tokenizable character.
+	*/
+TokenList Tokenizer::tokenize(std::string_view expression) {
+	LexemeList lexemes = scan(expression);
+
+	TokenList tokenizedExpression;
+	tokenizedExpression.reserve(lexemes.size());
+	for (Lexeme const& lexeme : lexemes)
+		tokenizedExpression.push_back(materialize(expression, lexeme));
 	return tokenizedExpression;
 }
 
@@ -223,6 +329,33 @@ TokenList Tokenizer::tokenize(string_type const& expression) {
 
 Revision History
 
+Version 0.10.0: 2026-10-18
+Long Integer literals are parsed by from_decimal().
+
+Version 0.9.0: 2026-10-18
+Variable names are interned to dense slots in a SymbolTable.
+
+Version 0.8.0: 2026-10-18
+New variables are given Environment slots.
+
+Version 0.7.0: 2026-10-18
+Added normalize().
+
+Version 0.6.0: 2026-10-18
+Operators, punctuation, keywords and small Integer literals are shared flyweight tokens.
+
+Version 0.5.0: 2026-10-18
+Tokenizing is split into scan(), which makes plain-data Lexemes from a string_view without copying, and materialize().
+
+Version 0.4.0: 2026-10-18
+Keywords are found case-insensitively through a compile-time perfect hash table shared by all tokenizers.
+
+Version 0.3.2: 2026-10-18
+Integer literals of up to 18 digits are built without going through cpp_int.
+
+Version 0.3.1: 2026-10-18
+Keyword table shares the process-wide Pi and E tokens.
+
 Version 0.3.0: 2017-11-23
 Added Python-style power operator '**'.
 
@@ -12,18 +12,46 @@
 	*/
 
 #include "token.hpp"
-#include <map>
+#include "symbol_table.hpp"
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 
+/** Lexeme kinds. */
+enum lexeme_kind_type : unsigned char {
+	LEX_INTEGER, LEX_REAL, LEX_KEYWORD, LEX_VARIABLE,
+	LEX_ADDITION, LEX_IDENTITY, LEX_SUBTRACTION, LEX_NEGATION,
+	LEX_MULTIPLICATION, LEX_DIVISION, LEX_MODULUS, LEX_POWER, LEX_FACTORIAL,
+	LEX_LESS, LEX_LESS_EQUAL, LEX_GREATER, LEX_GREATER_EQUAL, LEX_EQUALITY, LEX_INEQUALITY,
+	LEX_ASSIGNMENT, LEX_LEFT_PARENTHESIS, LEX_RIGHT_PARENTHESIS, LEX_ARGUMENT_SEPARATOR
+};
+
+
+/** A lexeme is a plain-data token: its kind and where its text is in the source.
+	Literals and names are not copied; Tokenizer::materialize() builds the Token on demand.
+	*/
+struct Lexeme {
+	lexeme_kind_type	kind;
+	unsigned char		keyword;	// keyword index of a LEX_KEYWORD
+	std::uint32_t		offset;
+	std::uint32_t		length;
+};
+
+using LexemeList = std::vector<Lexeme>;
+
+
 /** Tokenizer class is used to create lists of tokens from expression strings.
-	It maintains a dictionary of variable tokens introduced by the expression strings.
+	It maintains a dictionary of variable tokens introduced by the expression strings,
+	each with the dense slot its name is interned to.
 	*/
 class Tokenizer : boost::noncopyable {
 // types
 public:
 	typedef std::string	string_type;
+	typedef std::vector<Token::pointer_type>	dictionary_type;	// variable tokens, by slot
 
 	class XTokenizer : public std::exception {
 		string_type	expression_;
@@ -58,22 +86,30 @@ public:
 			: XTokenizer( expression, location, "Tokenizer::Too many digits in number." ) { }
 	};
 
-private:
-	typedef std::map<string_type,Token::pointer_type>	dictionary_type;
-
 // Data
 private:
-	dictionary_type	keywords_;
-	dictionary_type variables_;
+	SymbolTable		symbols_;
+	dictionary_type	variables_;
 
 // Methods
 public:
-	Tokenizer();
-	TokenList tokenize( string_type const& expression );
+	TokenList tokenize( std::string_view expression );
 
-private:
-	Token::pointer_type _get_identifier( Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression );
-	Token::pointer_type _get_number( Tokenizer::string_type::const_iterator& currentChar, Tokenizer::string_type const& expression );
+	/** Scans an expression into lexemes without building any Tokens. */
+	LexemeList scan( std::string_view expression ) const;
+
+	/** Gets the canonical text of an expression: its lexemes separated by single spaces, keywords in lower case.
+		Expressions that differ only in whitespace or keyword case have the same canonical text. */
+	string_type normalize( std::string_view expression ) const;
+
+	/** Builds the Token of a lexeme scanned from 'expression'. */
+	Token::pointer_type materialize( std::string_view expression, Lexeme const& lexeme );
+
+	/** Gets the variables introduced so far, by slot. */
+	dictionary_type const& get_variables() const { return variables_; }
+
+	/** Gets the names of the variables, by slot. */
+	SymbolTable const& get_symbols() const { return symbols_; }
 };
 
 
@@ -81,6 +117,21 @@ private:
 
 Revision History
 
+Version 0.6.0: 2026-10-18
+Variables are kept by slot; their names are in a SymbolTable.
+
+Version 0.5.0: 2026-10-18
+Added normalize().
+
+Version 0.4.0: 2026-10-18
+Added string_view scanning into plain-data Lexemes, and materialize().
+
+Version 0.3.0: 2026-10-18
+Removed the per-instance keyword dictionary.
+
+Version 0.2.0: 2026-10-18
+Added get_variables().
+
 Version 0.1.0: 2012-11-15
 Replaced BadCharacter with XTokenizer, XBadCharacter, and XNumericOverflow
 
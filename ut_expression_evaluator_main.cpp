@@ -7,6 +7,7 @@
 	\brief		Expression Evaluator unit test.
 	*/
 #include "../ee_common/inc/expression_evaluator.hpp"
+#include "../ee_common/inc/batch_evaluator.hpp"
 #include "../ee_common/inc/integer.hpp"
 #include "../ee_common/inc/real.hpp"
 #include "../ee_common/inc/variable.hpp"
@@ -16,7 +17,9 @@
 //#define _CRT_SECURE_NO_WARNINGS
 #define BOOST_TEST_MODULE ExpressionEvaluatorUnitTest
 #include <boost/test/unit_test.hpp>
+#include <random>
 #include <string>
+#include <thread>
 
 #include "../phase_list/ut_test_phase.hpp"
 
@@ -575,6 +578,178 @@ BOOST_AUTO_TEST_CASE( empty_expression ) {
 		}
 	#endif // TEST_MIXED
 
+	BOOST_AUTO_TEST_CASE(EE_prepared_expression) {
+		ExpressionEvaluator ee;
+		PreparedExpression expr = ee.compile("x * x + y");
+		BOOST_CHECK(expr.get_variables().size() == 2);
+		for (int x = 0; x < 5; ++x) {
+			expr.bind("x", make_operand<Integer>(x));
+			expr.bind("y", make_operand<Integer>(1));
+			BOOST_CHECK(get_value<Integer>(expr.evaluate()) == Integer::value_type(x * x + 1));
+		}
+
+		// bound values are the evaluator's variables
+		auto result = ee.evaluate("x");
+		BOOST_CHECK(get_value<Integer>(get_value<Variable>(result)) == Integer::value_type(4));
+
+		try {
+			expr.bind("z", make_operand<Integer>(0));
+			BOOST_FAIL("Failed to throw exception");
+		}
+		catch (std::exception& e) {
+			BOOST_CHECK(strcmp(e.what(), "Error: unknown variable <z>") == 0);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(EE_program_cache) {
+		ExpressionEvaluator ee;
+		ee.set_cache_capacity(2);
+		ee.evaluate("x = 3");
+		BOOST_CHECK(get_value<Integer>(ee.evaluate("abs(x) * 2")) == Integer::value_type(6));
+		ee.evaluate("x = x - 7");
+		BOOST_CHECK(get_value<Integer>(ee.evaluate("ABS( x )*2")) == Integer::value_type(8));
+		BOOST_CHECK(ee.get_cache().get_hits() == 1);
+		BOOST_CHECK(ee.get_cache().get_misses() == 3);
+		BOOST_CHECK(ee.get_cache().size() == 2);
+
+		// x = 3 was evicted
+		ee.evaluate("1 + 1");
+		ee.evaluate("x = 3");
+		BOOST_CHECK(ee.get_cache().get_misses() == 5);
+		BOOST_CHECK(ee.get_cache().size() == 2);
+
+		ee.set_cache_capacity(0);
+		BOOST_CHECK(ee.get_cache().size() == 0);
+		BOOST_CHECK(get_value<Integer>(ee.evaluate("x * 2")) == Integer::value_type(6));
+	}
+
+	BOOST_AUTO_TEST_CASE(EE_environment) {
+		ExpressionEvaluator ee;
+		ee.evaluate("x = 1");
+		PreparedExpression increment = ee.compile("x = x + 1");
+		Variable::slot_type const slot = increment.get_variables().at("x")->get_slot();
+
+		// a copy shares the values until it is assigned; a snapshot never changes
+		Environment copy = ee.get_environment();
+		Environment::snapshot_type before = copy.snapshot();
+		increment.evaluate(copy);
+		BOOST_CHECK(get_value<Integer>(copy.get(slot)) == Integer::value_type(2));
+		BOOST_CHECK(get_value<Integer>((*before)[slot]) == Integer::value_type(1));
+		BOOST_CHECK(get_value<Integer>(get_value<Variable>(ee.evaluate("x"))) == Integer::value_type(1));
+
+		// once nothing shares the values, assignments update them in place
+		before.reset();
+		Environment::slot_array_type const* array = copy.snapshot().get();
+		increment.evaluate(copy);
+		BOOST_CHECK(copy.snapshot().get() == array);
+		BOOST_CHECK(get_value<Integer>(copy.get(slot)) == Integer::value_type(3));
+
+		// one program, many environments at once
+		PreparedExpression square = ee.compile("y = x * x");
+		std::vector<Environment> environments(8);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 8; ++i) {
+			environments[i].set(slot, make_operand<Integer>(i));
+			threads.emplace_back([&, i] { for (int n = 0; n < 100; ++n) square.evaluate(environments[i]); });
+		}
+		for (auto& thread : threads)
+			thread.join();
+		Variable::slot_type const ySlot = square.get_variables().at("y")->get_slot();
+		for (int i = 0; i < 8; ++i)
+			BOOST_CHECK(get_value<Integer>(environments[i].get(ySlot)) == Integer::value_type(i * i));
+		BOOST_CHECK(!ee.get_environment().get(ySlot));
+	}
+
+	BOOST_AUTO_TEST_CASE(EE_batch_evaluation) {
+		std::vector<double> xs, ys;
+		for (int i = 0; i < 600; ++i) {
+			xs.push_back(i * 0.25 - 20);
+			ys.push_back(i % 7 + 0.5);
+		}
+
+		// the double tier runs column-wise and matches evaluating each row
+		ExpressionEvaluator ee;
+		ee.set_precision(PRECISION_DOUBLE);
+		for (char const* expression : { "x * x + 3 * y", "sin(x) / y - abs(x) ** 2", "max(x, y) + sqrt(y) * pi",
+			"x * (2 + 3) - y", "y / (pi * 2) + x ** (1 + 1)", "x - 10! / 7 + y", "x + 2 ** 70 - y" }) {
+			PreparedExpression expr = ee.compile(expression);
+			auto results = expr.evaluate_batch<double>({ { "x", &xs }, { "y", &ys } });
+			BOOST_REQUIRE(results.size() == xs.size());
+			for (size_t row = 0; row < xs.size(); ++row) {
+				expr.bind("x", make_operand<Real>(xs[row]));
+				expr.bind("y", make_operand<Real>(ys[row]));
+				BOOST_CHECK(results[row] == get_value<Real>(expr.evaluate()).convert_to<double>());
+			}
+		}
+
+		BOOST_CHECK_THROW(ee.compile("x > 0 and y > 1").evaluate_batch<double>({ { "x", &xs }, { "y", &ys } }), std::exception);
+
+		// other tiers run each row; unbound variables keep their value
+		ExpressionEvaluator wide;
+		PreparedExpression expr = wide.compile("x * y - 1");
+		expr.bind("y", make_operand<Integer>(3));
+		PreparedExpression::column_type<Real::value_type> column{ Real::value_type("0.5"), Real::value_type(2) };
+		auto results = expr.evaluate_batch<Real::value_type>({ { "x", &column } });
+		BOOST_CHECK(results[0] == Real::value_type("0.5"));
+		BOOST_CHECK(results[1] == Real::value_type(5));
+
+		BOOST_CHECK_THROW(expr.evaluate_batch<double>({ { "x", &xs } }), std::exception);
+		BOOST_CHECK_THROW(expr.evaluate_batch<Real::value_type>({ { "z", &column } }), std::exception);
+	}
+
+	BOOST_AUTO_TEST_CASE(EE_batch_power) {
+		std::mt19937 engine(17);
+		std::uniform_real_distribution<double> distribution(0.1, 100);
+		std::vector<double> xs;
+		for (int i = 0; i < 2000; ++i)
+			xs.push_back(distribution(engine));
+
+		// the column path raises powers with the same routine as the row kernels
+		ExpressionEvaluator ee;
+		ee.set_precision(PRECISION_DOUBLE);
+		for (char const* expression : { "x ** 3", "x ** 7", "x ** -3", "x ** 1.5", "pow(x, 2.5)", "pow(x, -0.125)" }) {
+			PreparedExpression expr = ee.compile(expression);
+			auto results = expr.evaluate_batch<double>({ { "x", &xs } });
+			BOOST_REQUIRE(results.size() == xs.size());
+			for (size_t row = 0; row < xs.size(); ++row) {
+				expr.bind("x", make_operand<Real>(xs[row]));
+				BOOST_CHECK(results[row] == get_value<Real>(expr.evaluate()).convert_to<double>());
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(EE_batch_evaluator) {
+		std::vector<BatchEvaluator::Job> jobs;
+		for (int i = 0; i < 300; ++i) {
+			switch (i % 3) {
+			case 0: jobs.push_back({ "x * y + 1", { { "x", make_operand<Integer>(i) }, { "y", make_operand<Integer>(i - 7) } } }); break;
+			case 1: jobs.push_back({ "x!", { { "x", make_operand<Integer>(i % 11 == 1 ? 900 : i % 20) } } }); break;
+			case 2: jobs.push_back({ "sin(x) + x", { { "x", make_operand<Real>(Real::value_type(i) / 8) } } }); break;
+			}
+		}
+
+		// results are in input order, and are those of evaluating each job alone
+		BatchEvaluator batch(4);
+		auto results = batch.evaluate(jobs);
+		BOOST_REQUIRE(results.size() == jobs.size());
+		ExpressionEvaluator ee;
+		for (size_t i = 0; i < jobs.size(); ++i) {
+			PreparedExpression expr = ee.compile(jobs[i].expression);
+			for (auto const& binding : jobs[i].bindings)
+				expr.bind(binding.first, binding.second);
+			BOOST_CHECK(results[i]->equals(*expr.evaluate()));
+		}
+
+		// a failing job throws once the batch has run
+		jobs[3].bindings["y"] = make_operand<Integer>(0);
+		jobs[3].expression = "x / y";
+		BOOST_CHECK_THROW(batch.evaluate(jobs), std::exception);
+		BOOST_CHECK_THROW(batch.evaluate({ { "x = 1", {} } }), std::exception);
+		BOOST_CHECK_THROW(batch.evaluate({ { "x + 1", { { "z", make_operand<Integer>(1) } } } }), std::exception);
+		BOOST_CHECK_THROW(batch.evaluate({ { "x + 1", {} } }), std::exception);
+		BOOST_CHECK(batch.evaluate({}).empty());
+	}
+
 	#if TEST_RESULT
 		BOOST_AUTO_TEST_CASE(express_result) {
 			ExpressionEvaluator ee;
@@ -586,6 +761,37 @@ BOOST_AUTO_TEST_CASE( empty_expression ) {
 			result = ee.evaluate("result(1)*result(2)");
 			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type("8"));
 		}
+
+		BOOST_AUTO_TEST_CASE(result_history) {
+			ExpressionEvaluator ee;
+			ResultHistory& history = ee.get_history();
+
+			// only the newest results are kept; they keep their kinds
+			history.set_capacity(3);
+			ee.evaluate("10");
+			ee.evaluate("true");
+			ee.evaluate("2.5");
+			ee.evaluate("20");
+			BOOST_CHECK(history.last() == 4);
+			BOOST_CHECK_THROW(ee.evaluate("result(1)"), std::exception);
+			BOOST_CHECK_THROW(ee.evaluate("result(5)"), std::exception);
+			BOOST_CHECK_THROW(ee.evaluate("result(1.5)"), std::exception);
+			BOOST_CHECK(get_value<Boolean>(ee.evaluate("result(2)")) == true);
+			BOOST_CHECK(get_value<Real>(ee.evaluate("result(3)*2")) == Real::value_type(5));
+			BOOST_CHECK(get_value<Integer>(ee.evaluate("result(-3)+1")) == Integer::value_type(21));
+			BOOST_CHECK(history.last() == 7);
+
+			// past the budget, the largest Integers are evicted first
+			history.set_capacity(8);
+			ee.evaluate("2**300");
+			ee.evaluate("2**100");
+			history.set_budget(history.get_bytes());
+			ee.evaluate("2**200");
+			BOOST_CHECK_THROW(history.get(8), std::exception);
+			BOOST_CHECK(std::get<Integer::value_type>(history.get(9)) == Integer::value_type(1) << 100);
+			BOOST_CHECK(std::get<Integer::value_type>(history.get(10)) == Integer::value_type(1) << 200);
+			BOOST_CHECK(history.get_bytes() <= history.get_budget());
+		}
 	#endif // TEST_RESULT
 #endif // TEST_VARIABLE
 
@@ -594,6 +800,24 @@ BOOST_AUTO_TEST_CASE( empty_expression ) {
 
 Revision History
 
+Version 1.6.0: 2026-10-18
+Added result history test.
+
+Version 1.5.0: 2026-10-18
+Added environment test.
+
+Version 1.4.0: 2026-10-18
+Added batch evaluator test.
+
+Version 1.3.0: 2026-10-18
+Added batch evaluation test.
+
+Version 1.2.0: 2026-10-18
+Added program cache test.
+
+Version 1.1.0: 2026-10-18
+Added prepared expression test.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -271,6 +271,36 @@ bool parse_test(TokenList const& infixTokenList, TokenList const & correct) {
 	#endif // TEST_VARIABLE
 
 
+	BOOST_AUTO_TEST_CASE(parser_left_assoc_same_precedence) {
+		BOOST_CHECK(parse_test(
+			// Test: 4-2+1
+			TokenList({ make<Integer>(4), make<Subtraction>(), make<Integer>(2), make<Addition>(), make<Integer>(1) }),
+			TokenList({ make<Integer>(4), make<Integer>(2), make<Subtraction>(), make<Integer>(1), make<Addition>() })
+			));
+	}
+
+	BOOST_AUTO_TEST_CASE(parser_unbalanced_parenthesis) {
+		BOOST_CHECK_THROW(Parser().parse(TokenList({ make<LeftParenthesis>(), make<Integer>(1) })), char const*);
+		BOOST_CHECK_THROW(Parser().parse(TokenList({ make<Integer>(1), make<RightParenthesis>() })), char const*);
+	}
+
+	BOOST_AUTO_TEST_CASE(parser_long_expression) {
+		// Test: 1-1*1-1*1 ... ; postfix is 1 1 1 * - 1 1 * - ...
+		TokenList infix({ make<Integer>(1) });
+		for (int i = 0; i < 50000; ++i) {
+			infix.push_back(make<Subtraction>());
+			infix.push_back(make<Integer>(1));
+			infix.push_back(make<Multiplication>());
+			infix.push_back(make<Integer>(1));
+		}
+		TokenList postfix = Parser().parse(infix);
+		BOOST_CHECK(postfix.size() == infix.size());
+		BOOST_CHECK(is<Multiplication>(postfix[3]));
+		BOOST_CHECK(is<Subtraction>(postfix[4]));
+		BOOST_CHECK(is<Subtraction>(postfix.back()));
+	}
+
+
 
 #endif // TEST_PARSER
 
@@ -279,6 +309,9 @@ bool parse_test(TokenList const& infixTokenList, TokenList const & correct) {
 
 Revision History
 
+Version 1.1.0: 2026-10-18
+Added associativity, parenthesis error and long expression tests.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
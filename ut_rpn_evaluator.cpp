@@ -14,9 +14,12 @@
 
 #include "../ee_common/inc/RPNEvaluator.hpp"
 #include "../ee_common/inc/boolean.hpp"
+#include "../ee_common/inc/compiler.hpp"
+#include "../ee_common/inc/factorial.hpp"
 #include "../ee_common/inc/integer.hpp"
 #include "../ee_common/inc/function.hpp"
 #include "../ee_common/inc/operator.hpp"
+#include "../ee_common/inc/power.hpp"
 #include "../ee_common/inc/real.hpp"
 #include "../ee_common/inc/variable.hpp"
 
@@ -162,6 +165,29 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 			auto result = RPNEvaluator().evaluate({ make<Integer>(5), make<Factorial>() });
 			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(120));
 		}
+		BOOST_AUTO_TEST_CASE(factorial_engine_test) {
+			Integer::value_type product = 1;
+			for (Integer::small_type n = 1; n <= 600; ++n) {
+				product *= n;
+				clear_factorial_cache();
+				BOOST_CHECK(factorial(n) == product);
+			}
+			BOOST_CHECK(factorial(650) == factorial(600) * factorial(650) / factorial(600));	// finished from the cached 600!
+			BOOST_CHECK(factorial(-3) == 1);
+			BOOST_CHECK_THROW(factorial(3000000000), std::exception);
+			size_t const limit = get_integer_result_limit();
+			set_integer_result_limit(1000);	// 1000! takes about 1067 bytes
+			BOOST_CHECK_THROW(factorial(1000), std::exception);
+			set_integer_result_limit(limit);
+
+			auto result = RPNEvaluator().evaluate({ make<Integer>(600), make<Factorial>() });
+			BOOST_CHECK(get_value<Integer>(result) == product);
+		#if TEST_REAL
+			result = RPNEvaluator().evaluate({ make<Real>(Real::value_type("300.5")), make<Factorial>() });
+			BOOST_CHECK(get_value<Real>(result) == Real::value_type(factorial(300)));
+			BOOST_CHECK(real_factorial<double>(171) == std::numeric_limits<double>::infinity());
+		#endif
+		}
 	#endif
 
 
@@ -203,6 +229,126 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 			auto result = RPNEvaluator().evaluate({ make<Integer>(3), make<Integer>(4), make<Power>() });
 			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(81));
 		}
+		BOOST_AUTO_TEST_CASE(test_power_kernel) {
+			Integer::value_type const huge("100000000000000000000001");
+			BOOST_CHECK(integer_power(Integer::value_type(-3), Integer::value_type(41)) == -boost::multiprecision::pow(Integer::value_type(3), 41));
+			BOOST_CHECK(integer_power(Integer::value_type(12), Integer::value_type(300)) == boost::multiprecision::pow(Integer::value_type(12), 300));
+			BOOST_CHECK(integer_power(Integer::value_type(-1), huge) == -1);
+			BOOST_CHECK(integer_power(Integer::value_type(1), huge) == 1);
+			BOOST_CHECK(integer_power_bytes(Integer::value_type(256), Integer::value_type(1000)) == 1000);
+			BOOST_CHECK_THROW(integer_power(Integer::value_type(2), huge), std::exception);
+
+			auto result = RPNEvaluator().evaluate({ make<Integer>(2), make<Integer>(200), make<Power>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(1) << 200);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(huge), make<Pow>() });
+			BOOST_CHECK(get_value<Integer>(result) == -1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(huge + 1), make<Pow>() });
+			BOOST_CHECK(get_value<Integer>(result) == 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(2), make<Power>() });
+			BOOST_CHECK(get_value<Integer>(result) == 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(0), make<Power>() });
+			BOOST_CHECK(get_value<Integer>(result) == 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(4), make<Pow>() });
+			BOOST_CHECK(get_value<Integer>(result) == 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-1), make<Integer>(Integer::value_type(1) << 62), make<Power>() });
+			BOOST_CHECK(get_value<Integer>(result) == 1);
+		#if TEST_REAL
+			result = RPNEvaluator().evaluate({ make<Integer>(2), make<Integer>(-2), make<Power>() });
+			BOOST_CHECK(get_value<Real>(result) == Real::value_type("0.25"));
+			result = RPNEvaluator().evaluate({ make<Integer>(16), make<Real>(Real::value_type("1.5")), make<Power>() });
+			BOOST_CHECK(get_value<Real>(result) == 64);
+			result = RPNEvaluator().evaluate({ make<Integer>(4), make<Real>(Real::value_type("-0.5")), make<Power>() });
+			BOOST_CHECK(get_value<Real>(result) == Real::value_type("0.5"));
+			result = RPNEvaluator().evaluate({ make<Integer>(32), make<Real>(Real::value_type("0.6")), make<Pow>() });
+			BOOST_CHECK(get_value<Real>(result) == 8);
+			result = RPNEvaluator().evaluate({ make<Integer>(2), make<Real>(Real::value_type("0.5")), make<Power>() });
+			BOOST_CHECK(abs(get_value<Real>(result) - boost::math::constants::root_two<Real::value_type>()) < Real::value_type("1e-990"));
+		#endif
+		}
+		BOOST_AUTO_TEST_CASE(test_compiled_program) {
+			Program program = Compiler().compile({ make<Integer>(3), make<Integer>(4), make<Addition>(),
+				make<Integer>(Integer::value_type("100000000000000000000")), make<Multiplication>() });
+			BOOST_CHECK(program.get_code().size() == 5);
+			BOOST_CHECK(program.get_code()[0].opcode == OPC_PUSH_SMALL);
+			BOOST_CHECK(program.get_code()[3].opcode == OPC_PUSH_CONSTANT);
+			BOOST_CHECK(program.get_constants().size() == 1);
+			BOOST_CHECK(program.get_max_depth() == 2);
+
+			RPNEvaluator rpn;
+			BOOST_CHECK(get_value<Integer>(rpn.run(program)) == Integer::value_type("700000000000000000000"));
+			BOOST_CHECK(get_value<Integer>(rpn.run(program)) == Integer::value_type("700000000000000000000"));
+		}
+		BOOST_AUTO_TEST_CASE(test_constant_folding) {
+			// 2 * pi * r / sqrt(2)
+			auto r = make<Variable>();
+			TokenList expression{ make<Integer>(2), make<Pi>(), make<Multiplication>(), r, make<Multiplication>(),
+				make<Integer>(2), make<Sqrt>(), make<Division>() };
+			Program program = Compiler().compile(expression);
+			for (auto precision : { PRECISION_DOUBLE, PRECISION_50, PRECISION_100, PRECISION_1000 }) {
+				RPNEvaluator rpn(precision);
+				Program folded = Compiler().fold_constants(program, rpn);
+				BOOST_CHECK(folded.get_code().size() == 5);
+				BOOST_CHECK(folded.get_precision() == precision);
+				convert<Variable>(r)->set_value(make_operand<Real>(Real::value_type("1.5")));
+				BOOST_CHECK(rpn.run(folded)->equals(*rpn.run(program)));
+			}
+
+			// assignments and calls that fail are left for run time
+			TokenList assignment{ make<Variable>(), make<Integer>(1), make<Integer>(0), make<Division>(), make<Assignment>() };
+			Program folded = Compiler().fold_constants(Compiler().compile(assignment), RPNEvaluator());
+			BOOST_CHECK(folded.get_code().size() == 5);
+			BOOST_CHECK_THROW(RPNEvaluator().run(folded), std::exception);
+		}
+		BOOST_AUTO_TEST_CASE(test_short_circuit) {
+			// False and (x = True): the assignment is skipped
+			auto x = make<Variable>();
+			TokenList expression{ make<False>(), x, make<True>(), make<Assignment>(), make<And>() };
+			Program program = Compiler().compile(expression);
+			BOOST_CHECK(program.get_code().size() == 6);
+			BOOST_CHECK(program.get_code()[1].opcode == OPC_SHORT_CIRCUIT);
+			BOOST_CHECK(is<False>(RPNEvaluator().run(program)));
+			BOOST_CHECK(!convert<Variable>(x)->get_value());
+
+			// True and (x = True): both sides run
+			BOOST_CHECK(is<True>(RPNEvaluator().evaluate({ make<True>(), x, make<True>(), make<Assignment>(), make<And>() })));
+			BOOST_CHECK(is<True>(convert<Variable>(x)->get_value()));
+
+			// x or (1 / 0), x nor (1 / 0), false nand (1 / 0)
+			BOOST_CHECK(is<True>(RPNEvaluator().evaluate({ x, make<Integer>(1), make<Integer>(0), make<Division>(), make<Or>() })));
+			BOOST_CHECK(is<False>(RPNEvaluator().evaluate({ x, make<Integer>(1), make<Integer>(0), make<Division>(), make<Nor>() })));
+			BOOST_CHECK(is<True>(RPNEvaluator().evaluate({ make<False>(), make<Integer>(1), make<Integer>(0), make<Division>(), make<Nand>() })));
+
+			// (False and True) or ((True or False) and False), folded and not
+			TokenList nested{ make<False>(), make<True>(), make<And>(), make<True>(), make<False>(), make<Or>(), make<False>(), make<And>(), make<Or>() };
+			Program compiled = Compiler().compile(nested);
+			BOOST_CHECK(is<False>(RPNEvaluator().run(compiled)));
+			BOOST_CHECK(is<False>(RPNEvaluator().run(Compiler().fold_constants(compiled, RPNEvaluator()))));
+
+			// x and (2 + 3 > 4) or False: folding the right operand moves the jump targets
+			Program folded = Compiler().fold_constants(Compiler().compile({ x, make<Integer>(2), make<Integer>(3), make<Addition>(),
+				make<Integer>(4), make<Greater>(), make<And>(), make<False>(), make<Or>() }), RPNEvaluator());
+			BOOST_CHECK(folded.get_code().size() == 7);
+			BOOST_CHECK(is<True>(RPNEvaluator().run(folded)));
+			convert<Variable>(x)->set_value(make_boolean(false));
+			BOOST_CHECK(is<False>(RPNEvaluator().run(folded)));
+		}
+		BOOST_AUTO_TEST_CASE(test_overflow_promotes_Integer) {
+			Integer::small_type const big = std::numeric_limits<Integer::small_type>::max();
+			auto result = RPNEvaluator().evaluate({ make<Integer>(big), make<Integer>(1), make<Addition>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(big) + 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(big), make<Integer>(big), make<Multiplication>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(big) * big);
+			result = RPNEvaluator().evaluate({ make<Integer>(-big - 1), make<Negation>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(big) + 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(-big - 1), make<Integer>(-1), make<Division>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(big) + 1);
+			result = RPNEvaluator().evaluate({ make<Integer>(2), make<Integer>(64), make<Power>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type("18446744073709551616"));
+			result = RPNEvaluator().evaluate({ make<Integer>(25), make<Factorial>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type("15511210043330985984000000"));
+			result = RPNEvaluator().evaluate({ make<Integer>(-7), make<Integer>(3), make<Modulus>() });
+			BOOST_CHECK(get_value<Integer>(result) == Integer::value_type(-1));
+		}
 		#if TEST_VARIABLE
 			BOOST_AUTO_TEST_CASE( assignment_test ) {
 				auto result = RPNEvaluator().evaluate({ make<Variable>(), make<Integer>(4), make<Assignment>() });
@@ -309,7 +455,7 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 			result = RPNEvaluator().evaluate({ make<False>(), make<False>(), make<And>() });
 			BOOST_CHECK(get_value<Boolean>(result) == false);
 		}
-		/*BOOST_AUTO_TEST_CASE(test_nand) {
+		BOOST_AUTO_TEST_CASE(test_nand) {
 			auto result = RPNEvaluator().evaluate({ make<True>(), make<True>(), make<Nand>() });
 			BOOST_CHECK(get_value<Boolean>(result) == false);
 			result = RPNEvaluator().evaluate({ make<True>(), make<False>(), make<Nand>() });
@@ -318,8 +464,8 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 			BOOST_CHECK(get_value<Boolean>(result) == true);
 			result = RPNEvaluator().evaluate({ make<False>(), make<False>(), make<Nand>() });
 			BOOST_CHECK(get_value<Boolean>(result) == true);
-		}*/
-		/*BOOST_AUTO_TEST_CASE(test_nor) {
+		}
+		BOOST_AUTO_TEST_CASE(test_nor) {
 			auto result = RPNEvaluator().evaluate({ make<True>(), make<True>(), make<Nor>() });
 			BOOST_CHECK(get_value<Boolean>(result) == false);
 			result = RPNEvaluator().evaluate({ make<True>(), make<False>(), make<Nor>() });
@@ -328,7 +474,7 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 			BOOST_CHECK(get_value<Boolean>(result) == false);
 			result = RPNEvaluator().evaluate({ make<False>(), make<False>(), make<Nor>() });
 			BOOST_CHECK(get_value<Boolean>(result) == true);
-		}*/
+		}
 		BOOST_AUTO_TEST_CASE(test_or) {
 			auto result = RPNEvaluator().evaluate({ make<True>(), make<True>(), make<Or>() });
 			BOOST_CHECK(get_value<Boolean>(result) == true);
@@ -612,6 +758,12 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 				auto result = RPNEvaluator().evaluate({ make<Real>(Real::value_type("1.0")), make<Ln>() });
 				BOOST_CHECK(round(get_value<Real>(result)) == boost::multiprecision::log(Real::value_type("1.0")));
 			}
+			BOOST_AUTO_TEST_CASE(test_log) {
+				auto result = RPNEvaluator().evaluate({ make<Real>(Real::value_type("1000.0")), make<Log>() });
+				BOOST_CHECK(round(get_value<Real>(result)) == round(Real::value_type("3.0")));
+				result = RPNEvaluator().evaluate({ make<E>(), make<Ln>() });
+				BOOST_CHECK(round(get_value<Real>(result)) == round(Real::value_type("1.0")));
+			}
 			BOOST_AUTO_TEST_CASE(test_sin) {
 				auto result = RPNEvaluator().evaluate({ make<Real>(Real::value_type("0.0")), make<Sin>() });
 				BOOST_CHECK(round(get_value<Real>(result)) == Real::value_type("0.0"));
@@ -624,6 +776,18 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 				auto result = RPNEvaluator().evaluate({ make<Real>(Real::value_type("1.0")), make<Tan>() });
 				BOOST_CHECK(get_value<Real>(result) == tan(Real::value_type("1.0")));
 			}
+			BOOST_AUTO_TEST_CASE(test_precision_tiers) {
+				TokenList tl = { make<Real>(Real::value_type("2.0")), make<Sqrt>() };
+				auto result = RPNEvaluator(PRECISION_DOUBLE).evaluate(tl);
+				BOOST_CHECK(get_value<Real>(result) == Real::value_type(sqrt(2.0)));
+				result = RPNEvaluator(PRECISION_50).evaluate(tl);
+				BOOST_CHECK(get_value<Real>(result) == Real::value_type(sqrt(boost::multiprecision::cpp_dec_float_50(2))));
+				BOOST_CHECK(get_value<Real>(RPNEvaluator().evaluate(tl)) == sqrt(Real::value_type("2.0")));
+				BOOST_CHECK(precision_for_digits(10) == PRECISION_DOUBLE);
+				BOOST_CHECK(precision_for_digits(40) == PRECISION_50);
+				BOOST_CHECK(precision_for_digits(100) == PRECISION_100);
+				BOOST_CHECK(precision_for_digits(101) == PRECISION_1000);
+			}
 		#endif
 	#endif //TEST_SINGLE_ARG
 	#if TEST_MULTI_ARG
@@ -736,6 +900,30 @@ BOOST_AUTO_TEST_CASE(no_operand) {
 
 Revision History
 
+Version 1.8.0: 2026-10-18
+Added power kernel test.
+
+Version 1.7.0: 2026-10-18
+Added factorial engine test.
+
+Version 1.6.0: 2026-10-18
+Added short-circuit test.
+
+Version 1.5.0: 2026-10-18
+Added constant folding test.
+
+Version 1.4.0: 2026-10-18
+Added compiled program test.
+
+Version 1.3.0: 2026-10-18
+Added Integer overflow promotion test.
+
+Version 1.2.0: 2026-10-18
+Added precision tier test.
+
+Version 1.1.0: 2026-10-18
+Enabled Nand/Nor tests, added Log test.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -82,6 +82,43 @@ BOOST_AUTO_TEST_CASE( unknown_token ) {
 		BOOST_CHECK(e.get_location() == 0);
 	}
 }
+
+
+BOOST_AUTO_TEST_CASE(lexer_scan) {
+	Tokenizer tkn;
+	std::string_view expression = " -x1 + 25.5*sin(y)";
+	LexemeList lexemes = tkn.scan(expression);
+	BOOST_REQUIRE(lexemes.size() == 9);
+	BOOST_CHECK(lexemes[0].kind == LEX_NEGATION);
+	BOOST_CHECK(lexemes[1].kind == LEX_VARIABLE && expression.substr(lexemes[1].offset, lexemes[1].length) == "x1");
+	BOOST_CHECK(lexemes[2].kind == LEX_ADDITION);
+	BOOST_CHECK(lexemes[3].kind == LEX_REAL && expression.substr(lexemes[3].offset, lexemes[3].length) == "25.5");
+	BOOST_CHECK(lexemes[5].kind == LEX_KEYWORD);
+	BOOST_CHECK(tkn.get_variables().empty());
+
+	BOOST_CHECK(is<Variable>(tkn.materialize(expression, lexemes[1])));
+	BOOST_CHECK(tkn.get_variables().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(symbol_table_slots) {
+	SymbolTable symbols;
+	BOOST_CHECK(symbols.find("x") == SymbolTable::NO_SLOT);
+	for (int i = 0; i < 500; ++i)
+		BOOST_CHECK(symbols.intern("v" + std::to_string(i)) == SymbolTable::slot_type(i));
+	BOOST_CHECK(symbols.size() == 500);
+	BOOST_CHECK(symbols.intern("v250") == 250);
+	BOOST_CHECK(symbols.find("v499") == 499);
+	BOOST_CHECK(symbols.name(42) == "v42");
+	BOOST_CHECK(symbols.find("v500") == SymbolTable::NO_SLOT);
+
+	// the tokenizer gives each variable the slot of its name
+	Tokenizer tkn;
+	TokenList tokens = tkn.tokenize("b + a * b");
+	BOOST_CHECK(convert<Variable>(tokens[0])->get_slot() == 0);
+	BOOST_CHECK(convert<Variable>(tokens[2])->get_slot() == 1);
+	BOOST_CHECK(tokens[4].get() == tkn.get_variables()[0].get());
+	BOOST_CHECK(tkn.get_symbols().name(1) == "a");
+}
 #pragma endregion
 
 
@@ -239,6 +276,16 @@ BOOST_AUTO_TEST_CASE( unknown_token ) {
 			make<Abs>(), make<LeftParenthesis>(), make<Integer>(42), make<RightParenthesis>()
 		})));
 	}
+
+	BOOST_AUTO_TEST_CASE(lexer_keyword_case) {
+		BOOST_CHECK(test("ABS(1) aBs(2)", TokenList({
+			make<Abs>(), make<LeftParenthesis>(), make<Integer>(1), make<RightParenthesis>(),
+			make<Abs>(), make<LeftParenthesis>(), make<Integer>(2), make<RightParenthesis>()
+		})));
+		BOOST_CHECK(test("Arctan2(1,2)", TokenList({
+			make<Arctan2>(), make<LeftParenthesis>(), make<Integer>(1), make<ArgumentSeparator>(), make<Integer>(2), make<RightParenthesis>()
+		})));
+	}
 #endif // TEST_FUNCTION
 
 
@@ -462,7 +509,7 @@ BOOST_AUTO_TEST_CASE( unknown_token ) {
 
 #if TEST_VARIABLE
 	BOOST_AUTO_TEST_CASE(lexer_single_Variable) {
-		BOOST_CHECK(test("variable", TokenList({ make<Variable>() })));
+		BOOST_CHECK(test("variable", TokenList({ make<Variable>(Variable::slot_type(0)) })));
 	}
 
 	BOOST_AUTO_TEST_CASE(def_ctor_variable) {
@@ -484,7 +531,7 @@ BOOST_AUTO_TEST_CASE( unknown_token ) {
 	#if TEST_BINARY_OPERATOR && TEST_INTEGER
 		BOOST_AUTO_TEST_CASE(lexer_single_operator_assignment) {
 			BOOST_CHECK(test("a=2", TokenList({
-				make<Variable>(), make<Assignment>(), make<Integer>(2)
+				make<Variable>(Variable::slot_type(0)), make<Assignment>(), make<Integer>(2)
 			})));
 		}
 	#endif // TEST_BINARY_OPERATOR && TEST_INTEGER
@@ -507,6 +554,15 @@ BOOST_AUTO_TEST_CASE( unknown_token ) {
 
 Revision History
 
+Version 1.3.0: 2026-10-18
+Added symbol table test.
+
+Version 1.2.0: 2026-10-18
+Added scan test.
+
+Version 1.1.0: 2026-10-18
+Added keyword case test.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -22,7 +22,9 @@
 
 #include <boost/lexical_cast.hpp>
 using boost::lexical_cast;
+#include <cstdlib>
 #include <string>
+#include <unordered_set>
 using namespace std;
 
 #include "../phase_list/ut_test_phase.hpp"
@@ -95,6 +97,92 @@ BOOST_AUTO_TEST_CASE(integer_test) {
 #endif
 	BOOST_CHECK(is<Integer>(i));
 }
+
+BOOST_AUTO_TEST_CASE(integer_small_test) {
+	BOOST_CHECK(Integer(42).is_small());
+	BOOST_CHECK(Integer(Integer::value_type(42)).is_small());
+	BOOST_CHECK(Integer(Integer::value_type("-9223372036854775808")).is_small());
+	BOOST_CHECK(!Integer(Integer::value_type("9223372036854775808")).is_small());
+	BOOST_CHECK(Integer(Integer::value_type("9223372036854775808")).get_value() == Integer::value_type("9223372036854775808"));
+	BOOST_CHECK(Integer(-7).to_string() == "-7");
+
+	Integer::small_type r;
+	BOOST_CHECK(checked_add(1, 2, r) && r == 3);
+	BOOST_CHECK(!checked_add(numeric_limits<Integer::small_type>::max(), 1, r));
+	BOOST_CHECK(!checked_subtract(numeric_limits<Integer::small_type>::min(), 1, r));
+	BOOST_CHECK(checked_multiply(-3, 4, r) && r == -12);
+	BOOST_CHECK(!checked_multiply(Integer::small_type(1) << 32, Integer::small_type(1) << 31, r));
+}
+
+BOOST_AUTO_TEST_CASE(integer_decimal_test) {
+	BOOST_CHECK(to_decimal(Integer::value_type(0)) == "0");
+	BOOST_CHECK(to_decimal(Integer::value_type(-42)) == "-42");
+	BOOST_CHECK(from_decimal("000123") == 123);
+
+	Integer::value_type big = pow(Integer::value_type(7), 20000);
+	string const text = big.str();
+	BOOST_CHECK(to_decimal(big) == text);
+	BOOST_CHECK(to_decimal(-big, 4) == "-" + text);
+	BOOST_CHECK(from_decimal(text) == big);
+	BOOST_CHECK(from_decimal(text, 4) == big);
+	BOOST_CHECK(Integer(big).to_string() == text);
+
+	Integer::value_type round = pow(Integer::value_type(10), 5000);
+	BOOST_CHECK(to_decimal(round) == "1" + string(5000, '0'));
+	BOOST_CHECK(to_decimal(round - 1) == string(5000, '9'));
+}
+
+BOOST_AUTO_TEST_CASE(shared_token_test) {
+	BOOST_CHECK(flyweight<Addition>().get() == flyweight<Addition>().get());
+	BOOST_CHECK(is<Addition>(flyweight<Addition>()));
+	BOOST_CHECK(make_integer(5).get() == make_integer(5).get());
+	BOOST_CHECK(make_integer(100000).get() != make_integer(100000).get());
+	BOOST_CHECK(convert<Integer>(make_integer(-128))->get_value() == -128);
+	BOOST_CHECK(make_boolean(true).get() == make_boolean(true).get());
+	BOOST_CHECK(is<True>(make_boolean(true)));
+	BOOST_CHECK(is<False>(make_boolean(false)));
+}
+
+BOOST_AUTO_TEST_CASE(token_equality_test) {
+	BOOST_CHECK(make<Integer>(Integer::small_type(7)) == make<Integer>(Integer::value_type(7)));
+	BOOST_CHECK(make<Integer>(Integer::small_type(7)) != make<Integer>(Integer::small_type(8)));
+	BOOST_CHECK(make<Integer>(Integer::small_type(7)) != make<Real>(Real::value_type(7)));
+	BOOST_CHECK(make<Real>(Pi().get_value()) == Pi::instance());
+	BOOST_CHECK(make<Boolean>(true) == make<True>());
+	BOOST_CHECK(make<Addition>() == flyweight<Addition>());
+	BOOST_CHECK(make<Addition>() != make<Subtraction>());
+
+	auto x = make<Variable>(Variable::slot_type(0));
+	auto y = make<Variable>(Variable::slot_type(1));
+	convert<Variable>(x)->set_value(make_integer(1));
+	convert<Variable>(y)->set_value(make_integer(1));
+	BOOST_CHECK(x != y);
+	std::size_t const hash = x->hash();
+	convert<Variable>(x)->set_value(make_integer(2));
+	BOOST_CHECK(x->hash() == hash);
+	BOOST_CHECK(x == make<Variable>(Variable::slot_type(0)));
+
+	std::unordered_set<Token::pointer_type, TokenHash, TokenEqual> set;
+	set.insert(make<Integer>(Integer::value_type("123456789012345678901234567890")));
+	set.insert(make<Integer>(Integer::value_type("123456789012345678901234567890")));
+	set.insert(make<Real>(Real::value_type(0)));
+	set.insert(make<Real>(-Real::value_type(0)));
+	set.insert(make<True>());
+	set.insert(make<Boolean>(true));
+	BOOST_CHECK(set.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(token_kind_test) {
+	BOOST_CHECK(make<Addition>()->get_kind() == (TK_OPERATION | TK_OPERATOR | TK_BINARY_OPERATOR | TK_LASSOC_OPERATOR));
+	BOOST_CHECK(is<Addition>(make<Addition>()));
+	BOOST_CHECK(!is<Addition>(make<Subtraction>()));
+	BOOST_CHECK(is<PostfixOperator>(make<Factorial>()));
+	BOOST_CHECK(is<Real>(Pi::instance()) && is<Pi>(Pi::instance()) && !is<E>(Pi::instance()));
+	BOOST_CHECK(is<Boolean>(make<False>()) && !is<True>(make<False>()));
+	BOOST_CHECK(!is<Operand>(Token::pointer_type()));
+	BOOST_CHECK(!convert<Integer>(make<Real>()));
+	BOOST_CHECK(convert<Variable>(make<Variable>()));
+}
 #endif // TEST_INTEGER
 
 
@@ -156,6 +244,44 @@ BOOST_AUTO_TEST_CASE(real_test) {
 	BOOST_CHECK(!is<E>(pi));
 	BOOST_CHECK(is<Pi>(pi));
 }
+
+BOOST_AUTO_TEST_CASE(real_constants_test) {
+	BOOST_CHECK(&real_constants<Real::value_type>::pi() == &real_constants<Real::value_type>::pi());
+	BOOST_CHECK(real_constants<Real::value_type>::pi() == boost::math::constants::pi<Real::value_type>());
+	BOOST_CHECK(real_constants<Real::value_type>::e() == boost::math::constants::e<Real::value_type>());
+	BOOST_CHECK(real_constants<double>::pi() == boost::math::constants::pi<double>());
+
+	BOOST_CHECK(Pi::instance().get() == Pi::instance().get());
+	BOOST_CHECK(is<Pi>(Pi::instance()));
+	BOOST_CHECK(get_value<Real>(E::instance()) == boost::math::constants::e<Real::value_type>());
+}
+
+BOOST_AUTO_TEST_CASE(real_format_test) {
+	Real::value_type const third = Real::value_type(1) / 3;
+	BOOST_CHECK(format_real(third, FORMAT_FIXED, 3) == "0.333");
+	BOOST_CHECK(format_real(Real::value_type("-9.9996"), FORMAT_FIXED, 3) == "-10.000");
+	BOOST_CHECK(format_real(Real::value_type("0.0006"), FORMAT_FIXED, 3) == "0.001");
+	BOOST_CHECK(format_real(Real::value_type("0.0004"), FORMAT_FIXED, 3) == "0.000");
+	BOOST_CHECK(format_real(Real::value_type("123456.5"), FORMAT_SCIENTIFIC, 4) == "1.2346e+05");
+	BOOST_CHECK(format_real(Real::value_type("0.00012345"), FORMAT_SCIENTIFIC, 2) == "1.23e-04");
+	BOOST_CHECK(format_real(Real::value_type(0), FORMAT_SCIENTIFIC, 1) == "0.0e+00");
+	BOOST_CHECK(format_real(Real::value_type("2.5"), FORMAT_GENERAL, 0) == "2.5");
+	BOOST_CHECK(format_real(Real::value_type("1e300"), FORMAT_GENERAL, 6) == "1e+300");
+	BOOST_CHECK(format_real(get_value<Real>(Pi::instance()), FORMAT_GENERAL, 6) == "3.14159");
+	for (double d : { 0.1, 0.1 + 0.2, 1.0 / 3, 5e-324, 1.7976931348623157e308 }) {
+		Real::value_type const value(d);
+		Real::string_type const text = format_real(value, FORMAT_GENERAL, round_trip_digits(value, PRECISION_DOUBLE));
+		BOOST_CHECK(strtod(text.c_str(), nullptr) == d);
+	}
+	BOOST_CHECK(format_real(Real::value_type(0.1), FORMAT_GENERAL, round_trip_digits(Real::value_type(0.1), PRECISION_DOUBLE)) == "0.1");
+	BOOST_CHECK(round_trip_digits(Real::value_type(0.1 + 0.2), PRECISION_DOUBLE) == 17);
+	BOOST_CHECK(round_trip_digits(Real::value_type(1.0 / 3), PRECISION_DOUBLE) == 16);
+	BOOST_CHECK(Real(third).to_string() == "0." + string(numeric_limits<Real::value_type>::digits10, '3'));
+
+	char buffer[4];
+	BOOST_CHECK(format_real(buffer, buffer + sizeof(buffer), third, FORMAT_FIXED, 2).ptr == buffer + 4);
+	BOOST_CHECK(format_real(buffer, buffer + sizeof(buffer), third, FORMAT_FIXED, 3).ec == errc::value_too_large);
+}
 #endif // TEST_REAL
 
 
@@ -443,6 +569,27 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(Double_arg_function_test, T, double_arg_function_t
 
 Revision History
 
+Version 1.7.0: 2026-10-18
+Added Integer decimal conversion test.
+
+Version 1.6.0: 2026-10-18
+Added Real format test.
+
+Version 1.5.0: 2026-10-18
+Added token kind test.
+
+Version 1.4.0: 2026-10-18
+Added token equality test.
+
+Version 1.3.0: 2026-10-18
+Added shared token test.
+
+Version 1.2.0: 2026-10-18
+Added small Integer test.
+
+Version 1.1.0: 2026-10-18
+Added real_constants test.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
@@ -8,6 +8,7 @@
 	*/
 
 #include "../inc/variable.hpp"
+#include <functional>
 
 Token::string_type Variable::to_string() const {
 	if (!value_)
@@ -16,10 +17,29 @@ Token::string_type Variable::to_string() const {
 }
 
 
+/*! A Variable is identified by its slot, not by its value, so its hash survives assignment.
+	Variables without a slot are one anonymous variable. */
+bool Variable::equals(Token const& other) const {
+	auto rhs = dynamic_cast<Variable const*>(&other);
+	return rhs && slot_ == rhs->slot_;
+}
+
+
+std::size_t Variable::hash() const {
+	return Token::hash() ^ std::hash<slot_type>()(slot_);
+}
+
+
 /*=============================================================
 
 Revision History
 
+Version 1.2.0: 2026-10-18
+equals() and hash() use the slot instead of the value.
+
+Version 1.1.0: 2026-10-18
+Added equals() and hash().
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 
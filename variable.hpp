@@ -13,18 +13,28 @@
 
 
 
-/*! Variable operand token. */
+/*! Variable operand token.
+	A Variable with a slot keeps its value in an Environment when evaluated with one;
+	otherwise the value is held by the token itself. */
 class Variable : public Operand {
+	DEF_TOKEN_KIND(Variable, Operand, TK_VARIABLE)
 public:
 	DEF_POINTER_TYPE(Variable)
 	using value_type = Operand::pointer_type;
+	using slot_type = std::size_t;
+	static constexpr slot_type NO_SLOT = slot_type(-1);
 private:
 	value_type	value_;
+	slot_type	slot_ = NO_SLOT;
 public:
-	Variable() = default;
-	value_type				get_value() const { return value_; }
+	explicit Variable(slot_type slot) : Variable() { slot_ = slot; }
+
+	slot_type				get_slot() const { return slot_; }
+	value_type const&		get_value() const { return value_; }
 	void					set_value(Operand::pointer_type const& value) { value_ = value; }
 	string_type				to_string() const override;
+	bool					equals(Token const& other) const override;
+	std::size_t				hash() const override;
 };
 
 
@@ -32,6 +42,21 @@ public:
 
 Revision History
 
+Version 1.5.0: 2026-10-18
+Variables compare and hash by their slot.
+
+Version 1.4.0: 2026-10-18
+get_value() returns a reference.
+
+Version 1.3.0: 2026-10-18
+Added Environment slot.
+
+Version 1.2.0: 2026-10-18
+Added token kind.
+
+Version 1.1.0: 2026-10-18
+Variables compare and hash by their current value.
+
 Version 1.0.0: 2019-11-05
 C++ 17 cleanup
 